@@ -13,7 +13,7 @@ CLASS_DEF(DAY) {
 public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
+    void parse(Input &input) override {
 
     }
 
@@ -13,9 +13,9 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        std::getline(input, line);
+    void parse(Input &input) override {
+        std::string_view line;
+        input.getline(line);
 
         std::ranges::for_each(line, [this](char c)
         {
@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 2
 
@@ -13,16 +14,7 @@ struct Row
 {
     std::vector<int> numbers;
 
-    explicit Row(const std::string& line)
-    {
-        int v;
-        std::istringstream iss(line);
-        while (! iss.eof())
-        {
-            iss >> v;
-            numbers.push_back(v);
-        }
-    }
+    explicit Row(std::string_view line) : numbers(Scanner(line).integers()) {}
 
     [[nodiscard]] int get_largest_diff() const
     {
@@ -69,9 +61,9 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        while (std::getline(input, line))
+    void parse(Input &input) override {
+        std::string_view line;
+        while (input.getline(line))
         {
             sheets.emplace_back(line);
         }
@@ -94,7 +86,7 @@ CLASS_DEF(DAY) {
     }
 
     void parseBenchReset() override {
-        // none
+        sheets.clear();
     }
 
     private:
@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 3
 
@@ -13,8 +14,8 @@ NAMESPACE_DEF(DAY) {
         public:
         DEFAULT_CTOR_DEF(DAY)
 
-        void parse(std::ifstream &input) override {
-            input >> N;
+        void parse(Input &input) override {
+            N = Scanner(input.rest()).integer();
 
             if (N < 0) throw std::invalid_argument("N must be positive");
         }
@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 4
 
@@ -13,9 +14,9 @@ NAMESPACE_DEF(DAY) {
         public:
         DEFAULT_CTOR_DEF(DAY)
 
-        void parse(std::ifstream &input) override {
+        void parse(Input &input) override {
             std::string line;
-            while (std::getline(input, line))
+            while (input.getline(line))
             {
                 passphrases.emplace_back(line);
             }
@@ -36,12 +37,10 @@ NAMESPACE_DEF(DAY) {
         static bool is_passphrase_valid(const std::string& s, bool anagram_check = false)
         {
             std::set<std::string> words;
-            std::string tmp;
-            std::istringstream ss(s);
-            while (ss.good())
+            Scanner scan(s);
+            for (auto word = scan.word(); ! word.empty(); word = scan.word())
             {
-                ss >> tmp;
-                auto [_, new_word] = words.emplace(tmp);
+                auto [_, new_word] = words.emplace(word);
 
                 if (!new_word) return false;
             }
@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 5
 
@@ -13,12 +14,8 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        while (std::getline(input, line))
-        {
-            offsets.emplace_back(std::stoi(line));
-        }
+    void parse(Input &input) override {
+        offsets = Scanner(input.rest()).integers(); // one per line.
     }
 
     static int traverse_and_count_until_exit(std::vector<int>& jumps, bool insane_rules = false)
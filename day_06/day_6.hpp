@@ -1,9 +1,11 @@
 #pragma once
 
 #include <iostream>
+#include <set>
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 6
 
@@ -85,22 +87,15 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        std::getline(input, line);
-        std::istringstream iss(line);
-
-        while (iss.good())
-        {
-            int x;
-            iss >> x;
-            inputs.emplace_back(x);
-        }
+    void parse(Input &input) override {
+        std::string_view line;
+        input.getline(line);
+        inputs = Scanner(line).integers();
     }
 
     static size_t rebalance_until_cycle(MemoryBanks& b)
     {
-        std::set<__int128_t> seen;
+        std::pmr::set<__int128_t> seen(scratch());
         seen.emplace(b.serialize());
 
         while (true)
@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 7
 
@@ -39,7 +40,7 @@ struct Node
         bool ok = true;
         std::ranges::for_each(children, [&ok, &the_weight](auto& node)
         {
-            std::cout << "For node " << node->name << " The total weight is " << node->get_total_weight() << std::endl;
+            LOG_TRACE("For node " << node->name << " The total weight is " << node->get_total_weight());
             ok &= the_weight == node->get_total_weight();
         });
 
@@ -60,31 +61,26 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
+    void parse(Input &input) override {
+        std::string_view line;
         std::map<std::string, std::vector<std::string>> post_process_step;
-        while (std::getline(input, line))
+        while (input.getline(line))
         {
-            std::istringstream iss(line);
-            std::string name;
-            iss >> name;
-            std::string value;
-            iss >> value;
-            int weight = std::stoi(value.substr(1, value.length() - 2));
+            Scanner scan(line);
+            std::string name(scan.word());
+            scan.expect(" (");
+            int weight = scan.integer();
+            scan.expect(")");
 
             Node new_node { name, {}, weight };
 
             std::vector<std::string> node_child_by_name;
-            if (iss.peek() != EOF) // this has children
+            if (scan.skip(" -> ")) // this has children
             {
-                std::string child;
-                iss >> child; // eat the arrow symbol.
-                while (iss.good())
+                while (! scan.done())
                 {
-                    iss >> child;
-                    // hate dealing with that comma.
-                    child = child.substr(0, ',' == *child.rbegin() ? child.length() - 1 : child.length());
-                    node_child_by_name.emplace_back(child);
+                    node_child_by_name.emplace_back(scan.until(','));
+                    scan.skip_spaces();
                 }
             }
 
@@ -121,7 +117,7 @@ CLASS_DEF(DAY) {
 
         std::ranges::for_each(graph, [](auto& kvp)
         {
-            std::cout << kvp.second << "\n";
+            LOG_DEBUG(kvp.second);
         });
     }
 
@@ -5,6 +5,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 8
 
@@ -69,26 +70,18 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        while (std::getline(input, line))
+    void parse(Input &input) override {
+        std::string_view line;
+        while (input.getline(line))
         {
-            std::string the_register;
-            std::string opcode;
-            std::string value;
-            std::string if_statement_ignored;
-            std::string conditional_register;
-            std::string comparator;
-            std::string compared_value;
-
-            std::istringstream iss(line);
-            iss >> the_register;
-            iss >> opcode;
-            iss >> value;
-            iss >> if_statement_ignored;
-            iss >> conditional_register;
-            iss >> comparator;
-            iss >> compared_value;
+            Scanner scan(line);
+            std::string_view the_register = scan.word();
+            std::string_view opcode = scan.word();
+            int the_value = scan.integer();
+            scan.expect(" if ");
+            std::string_view conditional_register = scan.word();
+            std::string_view comparator = scan.word();
+            int the_compared_value = scan.integer();
 
             Opcode the_opcode;
             if (opcode == "dec")
@@ -97,12 +90,9 @@ CLASS_DEF(DAY) {
             } else if (opcode == "inc")
             {
                 the_opcode = Opcode::INC;
-            } else throw std::logic_error("Unknown opcde: " + opcode);
+            } else throw std::logic_error("Unknown opcde: " + std::string(opcode));
 
-            int the_value = std::stoi(value);
-            int the_compared_value = std::stoi(compared_value);
-
-            instructions.emplace_back(the_register, the_opcode, the_value, conditional_register, comparator, the_compared_value);
+            instructions.emplace_back(std::string(the_register), the_opcode, the_value, std::string(conditional_register), std::string(comparator), the_compared_value);
         }
 
         // std::ranges::for_each(instructions, [](auto& i) { std::cout << i << "\n"; });
@@ -15,8 +15,8 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::getline(input, stream);
+    void parse(Input &input) override {
+        input.getline(stream);
     }
 
     static int proceed_iter_until_end_of_garbage(std::string::const_iterator& iter, const Sentinel& sentinel)
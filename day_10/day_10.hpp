@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 10
 
@@ -13,30 +14,19 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        std::getline(input, line);
-        std::istringstream iss(line);
-
-        while (iss.peek() != EOF)
+    void parse(Input &input) override {
+        std::string_view line;
+        input.getline(line);
+        ranges = Scanner(line).integers<uint16_t>();
+        for (auto length : ranges)
         {
-            int total = 0;
-            int c;
-            while ((c = iss.get()) != ',' && c != EOF)
-            {
-                total = total * 10 + (c - '0');
-            }
-            ranges.emplace_back(total);
+            if (length > 256) throw std::invalid_argument("length " + std::to_string(length) + " is longer than the list");
         }
 
         // std::ranges::for_each(ranges, [](int v) { std::cout << v << ", "; });
         // std::cout << "\n";
 
-        iss = std::istringstream(line);
-        while (iss.peek() != EOF)
-        {
-            ascii_ranges.emplace_back(static_cast<char>(iss.get()));
-        }
+        ascii_ranges.assign(line.begin(), line.end());
         ascii_ranges.emplace_back(17);
         ascii_ranges.emplace_back(31);
         ascii_ranges.emplace_back(73);
@@ -47,9 +37,11 @@ CLASS_DEF(DAY) {
         // std::cout << "\n";
     }
 
-    static void knot_hash_step(uint8_t& position, uint8_t& skip_size, std::array<uint8_t, 256>& numbers, const std::vector<uint8_t>& inputs)
+    // lengths up to 256, the whole list. Positions are uint8_t so they wrap around the list by themselves.
+    template<typename Length>
+    static void knot_hash_step(uint8_t& position, uint8_t& skip_size, std::array<uint8_t, 256>& numbers, const std::vector<Length>& inputs)
     {
-        for (uint8_t range : inputs)
+        for (int range : inputs)
         {
             uint8_t start = position;
             uint8_t end = position + range - 1;
@@ -144,7 +136,7 @@ CLASS_DEF(DAY) {
     }
 
     private:
-    std::vector<uint8_t> ranges;
+    std::vector<uint16_t> ranges;
     std::vector<uint8_t> ascii_ranges;
 };
 
@@ -90,8 +90,8 @@ struct State
             }
         }
 
-        std::cout << "hdist " << h_dist << std::endl;
-        std::cout << "vdist " << v_dist << std::endl;
+        LOG_TRACE("hdist " << h_dist);
+        LOG_TRACE("vdist " << v_dist);
 
 
         return v_dist + h_dist;
@@ -126,9 +126,9 @@ CLASS_DEF(DAY) {
         }
     }
 
-    void parse(std::ifstream &input) override {
-        std::string sequence;
-        std::getline(input, sequence);
+    void parse(Input &input) override {
+        std::string_view sequence;
+        input.getline(sequence);
 
         std::array<char, 2> type{};
         int i = 0;
@@ -168,7 +168,7 @@ CLASS_DEF(DAY) {
     }
 
     void parseBenchReset() override {
-        // none
+        directions.clear();
     }
 
     private:
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <iostream>
+#include <deque>
 #include <queue>
+#include <set>
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 12
 
@@ -20,39 +23,16 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
+    void parse(Input &input) override {
+        std::string_view line;
         std::map<int, std::vector<int>> connections;
-        while (std::getline(input, line))
+        while (input.getline(line))
         {
-            std::istringstream iss(line);
-            int node_id;
-            iss >> node_id; // technically redundant, input is ordered for the left side of the <->.
-            iss.get();
-            iss.get();
-            iss.get();
-            iss.get();
-            iss.get(); // ' <-> '
-
-            std::vector<int> connections_of_node;
-            int digit = 0;
-            int read;
-            while ((read = iss.get()) != EOF)
-            {
-                if (read == ',')
-                {
-                    iss.get(); // space
-                    connections_of_node.emplace_back(digit);
-                    digit = 0;
-                } else
-                {
-                    digit = digit * 10 + (read - '0');
-                }
-            }
-            // after loop exit by EOF.
-            connections_of_node.emplace_back(digit);
+            Scanner scan(line);
+            int node_id = scan.integer(); // technically redundant, input is ordered for the left side of the <->.
+            scan.expect(" <-> ");
 
-            connections.emplace(node_id, std::move(connections_of_node));
+            connections.emplace(node_id, scan.integers());
         }
 
         for (const auto& k : connections | std::views::keys)
@@ -77,9 +57,9 @@ CLASS_DEF(DAY) {
         // });
     }
 
-    static int count_network_members(const Node& s, std::set<const Node*>& seen_set_out)
+    static int count_network_members(const Node& s, std::pmr::set<const Node*>& seen_set_out)
     {
-        std::queue<const Node*> work;
+        std::queue<const Node*, std::pmr::deque<const Node*>> work(scratch());
         seen_set_out.clear();
 
         work.emplace(&s);
@@ -103,19 +83,19 @@ CLASS_DEF(DAY) {
 
     void v1() const override {
         // use DFS or BFS to find the size of the network that has node '0' in it.
-        std::set<const Node*> _; // used for P2 only.
+        std::pmr::set<const Node*> _(scratch()); // used for P2 only.
         reportSolution(count_network_members(graph.at(0), _));
     }
 
     void v2() const override {
-        std::set<int> in_group;
+        std::pmr::set<int> in_group(scratch());
 
         int groups = 0;
         for (auto& v : graph | std::views::values)
         {
             if (! in_group.contains(v.id))
             {
-                std::set<const Node*> group_members;
+                std::pmr::set<const Node*> group_members(scratch());
                 ++groups;
                 count_network_members(v, group_members);
 
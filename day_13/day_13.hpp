@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 13
 
@@ -28,16 +29,14 @@ NAMESPACE_DEF(DAY) {
         public:
         DEFAULT_CTOR_DEF(DAY)
 
-        void parse(std::ifstream &input) override {
-            std::string line;
-            while (std::getline(input, line))
+        void parse(Input &input) override {
+            std::string_view line;
+            while (input.getline(line))
             {
-                int a;
-                int b;
-                std::istringstream iss(line);
-                iss >> a;
-                iss.get();
-                iss >> b;
+                Scanner scan(line);
+                int a = scan.integer();
+                scan.expect(":");
+                int b = scan.integer();
 
                 layers.emplace_back(a, b);
             }
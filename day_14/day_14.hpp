@@ -1,6 +1,9 @@
 #pragma once
 
 #include <iostream>
+#include <deque>
+#include <queue>
+#include <set>
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
@@ -15,8 +18,8 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::getline(input, key);
+    void parse(Input &input) override {
+        input.getline(key);
     }
 
     static std::array<uint8_t, 256> get_initial_knot_hash()
@@ -53,6 +56,7 @@ CLASS_DEF(DAY) {
 
     void make_grid(std::array<std::array<bool, 128>, 128>& out) const
     {
+        TRACE_ZONE("make_grid"); // nearly all of it is the 128 knot hashes.
         std::array<std::array<uint8_t, 16>, 128> hashes {};
         for (int i = 0; i < hashes.size(); ++i)
         {
@@ -90,13 +94,13 @@ CLASS_DEF(DAY) {
         reportSolution(occupied);
     }
 
-    static void mark_region(const int y, const int x, std::set<int>& seen,
+    static void mark_region(const int y, const int x, std::pmr::set<int>& seen,
                      const std::function<bool(int, int)>& coordinate_occupancy_checker,
                      const std::function<int(int, int)>& coordinate_int_converter) // maybe lambdas was not the best idea.
     {
         // auto start_size = seen.size();
         seen.emplace(coordinate_int_converter(x, y));
-        std::queue<std::pair<int,int>> work;
+        std::queue<std::pair<int,int>, std::pmr::deque<std::pair<int,int>>> work(scratch());
         work.emplace(y,x);
 
         while (! work.empty())
@@ -153,8 +157,9 @@ CLASS_DEF(DAY) {
             return y * grid_size + x;
         };
 
+        TRACE_ZONE("flood fill");
         int regions = 0;
-        std::set<int> seen;
+        std::pmr::set<int> seen(scratch());
         for (int i = 0; i < grid.size(); ++i)
         {
             for (int j = 0; j < grid.at(i).size(); ++j)
@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 15
 
@@ -41,20 +42,18 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string gen_a_line;
-        std::string gen_b_line;
-        std::getline(input, gen_a_line);
-        std::getline(input, gen_b_line);
-
-        constexpr std::string_view skip_string = "Generator X starts with ";
-        auto skipper = [&](std::istringstream& ss) {std::ranges::for_each(skip_string, [&](auto _) { ss.get(); }); };
-        std::istringstream iss(gen_a_line);
-        skipper(iss);
-        iss >> A_start;
-        iss = std::istringstream(gen_b_line);
-        skipper(iss);
-        iss >> B_start;
+    void parse(Input &input) override {
+        std::string_view gen_a_line;
+        std::string_view gen_b_line;
+        input.getline(gen_a_line);
+        input.getline(gen_b_line);
+
+        Scanner a(gen_a_line);
+        a.expect("Generator A starts with ");
+        A_start = a.integer<decltype(A_start)>();
+        Scanner b(gen_b_line);
+        b.expect("Generator B starts with ");
+        B_start = b.integer<decltype(B_start)>();
 
         // std::cout << A_start << " " << B_start << std::endl;
     }
@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 16
 
@@ -46,11 +47,20 @@ struct State
     }
 };
 
+// a move as plain data, for snapshots: 's' amount, 'x' posA posB or 'p' a b.
+struct PackedMove
+{
+    char type;
+    int a;
+    int b;
+};
+
 class Move
 {
 public:
     virtual ~Move() = default;
     virtual void execute(State& state) const = 0;
+    [[nodiscard]] virtual PackedMove packed() const = 0;
 };
 
 class Spin : public Move
@@ -60,6 +70,8 @@ class Spin : public Move
 public:
     explicit Spin(int a) : Move(), amount(a) {}
 
+    [[nodiscard]] PackedMove packed() const override { return { 's', amount, 0 }; }
+
     void execute(State& state) const override
     {
         // std::cout << "Execute Spin with " << amount << std::endl;
@@ -82,6 +94,8 @@ class Exchange : public Move
 public:
     Exchange(int a, int b) : Move(), posA(a), posB(b) {}
 
+    [[nodiscard]] PackedMove packed() const override { return { 'x', posA, posB }; }
+
     void execute(State& state) const override
     {
         // std::cout << "Execute Exchange with: " << posA << " " << posB << std::endl;
@@ -100,6 +114,8 @@ class Partner : public Move
 public:
     Partner(char _a, char _b) : Move(), a(_a), b(_b) {}
 
+    [[nodiscard]] PackedMove packed() const override { return { 'p', a, b }; }
+
     void execute(State& state) const override
     {
         // std::cout << "Execute Partner with: " << a << " " << b << std::endl;
@@ -111,60 +127,70 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        std::getline(input, line);
-
-        std::istringstream iss(line);
-        std::ostringstream oss;
+    void parse(Input &input) override {
+        std::string_view line;
+        input.getline(line);
 
-        auto commit = [this](const std::string& token)
+        Scanner scan(line);
+        while (! scan.done())
         {
             std::unique_ptr<Move> m;
-            char mode = token.at(0);
+            char mode = scan.get();
             switch (mode)
             {
                 case 's':
-                    m = std::make_unique<Spin>(std::stoi(token.substr(1)));
+                    m = std::make_unique<Spin>(scan.integer());
                     break;
                 case 'x':
                 {
-                    size_t split = token.find_first_of('/');
-                    int left = std::stoi(token.substr(1, split - 1));
-                    int right = std::stoi(token.substr(split + 1));
+                    int left = scan.integer();
+                    scan.expect("/");
+                    int right = scan.integer();
                     m = std::make_unique<Exchange>(left, right);
                     break;
                 }
                 case 'p':
                 {
-                    size_t split = token.find_first_of('/');
-                    m = std::make_unique<Partner>(token.at(split-1), token.at(split+1));
+                    char a = scan.get();
+                    scan.expect("/");
+                    m = std::make_unique<Partner>(a, scan.get());
                     break;
                 }
-                default: throw std::logic_error("Unknown input: " + token);
+                default: throw std::logic_error("Unknown input: " + std::string(1, mode));
             }
 
             moves.emplace_back(std::move(m));
-        };
+            scan.skip(",");
+        }
+    }
 
-        while (iss.peek() != EOF)
+    [[nodiscard]] bool hasSnapshotFormat() const override { return true; }
+
+    void save(Snapshot::Writer& out) const override {
+        std::vector<PackedMove> packed;
+        packed.reserve(moves.size());
+        for (auto& m : moves) packed.push_back(m->packed());
+        out.put(std::span<const PackedMove>(packed));
+    }
+
+    void load(Snapshot::Reader& in) override {
+        auto packed = in.array<PackedMove>();
+        moves.reserve(packed.size());
+        for (auto& [type, a, b] : packed)
         {
-            char c = static_cast<char>(iss.get());
-            if (c == ',')
-            {
-                commit(oss.str());
-                oss = std::ostringstream();
-            } else
+            switch (type)
             {
-                oss << c;
+                case 's': moves.emplace_back(std::make_unique<Spin>(a)); break;
+                case 'x': moves.emplace_back(std::make_unique<Exchange>(a, b)); break;
+                case 'p': moves.emplace_back(std::make_unique<Partner>(static_cast<char>(a), static_cast<char>(b))); break;
+                default: throw std::invalid_argument("snapshot: unknown move " + std::string(1, type));
             }
         }
-        commit(oss.str());
     }
 
     void v1() const override {
         State s = { initial_state };
-        std::cout << "Initial state:\n";
+        LOG_DEBUG("Initial state:");
         // std::cout << s.print();
         for (auto& m : moves)
         {
@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 17
 
@@ -13,10 +14,8 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        std::getline(input, line);
-        jump_size = std::stoi(line);
+    void parse(Input &input) override {
+        jump_size = Scanner(input.rest()).integer();
     }
 
     static void insert_after(int i, int v, std::deque<int>& deque)
@@ -57,7 +56,7 @@ CLASS_DEF(DAY) {
         int d_index = 1;
         for (int i = 2; i <= 50'000'000; ++i)
         {
-            if (i%1'000'000 == 0) std::cout << i << "\n";
+            if (i%1'000'000 == 0) LOG_DEBUG(i);
 
             int new_index = (d_index + jump_size) % static_cast<int>(values.size());
             insert_after(new_index, i, values);
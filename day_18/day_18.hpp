@@ -4,15 +4,10 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 18
 
-#define QUIET true
-
-#if QUIET
-#define cout ostringstream{} // just nuke all the std::cout, convert to a stringstream that does not get used. I wonder if compilation will then optimize out the operation?
-#endif
-
 NAMESPACE_DEF(DAY) {
 
 using Register_t = std::map<char, int64_t>;
@@ -103,7 +98,7 @@ struct SoundInstruction : Instruction
 
     void Execute(Device& d) const override
     {
-        std::cout << "Play sound with " << operands.at(0)->get_register_name() << " (" << operands.at(0)->get_value(d.registers) << ")" << std::endl;
+        LOG_TRACE("Play sound with " << operands.at(0)->get_register_name() << " (" << operands.at(0)->get_value(d.registers) << ")");
         d.last_played_sound = operands.at(0)->get_value(d.registers);
     }
 };
@@ -118,7 +113,7 @@ struct SetInstruction : Instruction
 
     void Execute(Device& d) const override
     {
-        std::cout << "Set value with " << operands.at(0)->get_register_name() << " (" << operands.at(0)->get_value(d.registers) << ") - (" << operands.at(1)->get_value(d.registers) << ") " << std::endl;
+        LOG_TRACE("Set value with " << operands.at(0)->get_register_name() << " (" << operands.at(0)->get_value(d.registers) << ") - (" << operands.at(1)->get_value(d.registers) << ") ");
         d.registers.at(operands.at(0)->get_register_name()) = operands.at(1)->get_value(d.registers);
     }
 };
@@ -133,7 +128,7 @@ struct AddInstruction : Instruction
 
     void Execute(Device& d) const override
     {
-        std::cout << "Add value with " << operands.at(0)->get_register_name() << " (" << operands.at(0)->get_value(d.registers) << ") - (" << operands.at(1)->get_value(d.registers) << ") " << std::endl;
+        LOG_TRACE("Add value with " << operands.at(0)->get_register_name() << " (" << operands.at(0)->get_value(d.registers) << ") - (" << operands.at(1)->get_value(d.registers) << ") ");
         auto& out = d.registers.at(operands.at(0)->get_register_name());
         out = operands.at(0)->get_value(d.registers) + operands.at(1)->get_value(d.registers);
     }
@@ -149,7 +144,7 @@ struct MultiplyInstruction : Instruction
 
     void Execute(Device& d) const override
     {
-        std::cout << "Mult value with " << operands.at(0)->get_register_name() << " (" << operands.at(0)->get_value(d.registers) << ") - (" << operands.at(1)->get_value(d.registers) << ") " << std::endl;
+        LOG_TRACE("Mult value with " << operands.at(0)->get_register_name() << " (" << operands.at(0)->get_value(d.registers) << ") - (" << operands.at(1)->get_value(d.registers) << ") ");
         auto& out = d.registers.at(operands.at(0)->get_register_name());
         out = operands.at(0)->get_value(d.registers) * operands.at(1)->get_value(d.registers);
     }
@@ -165,7 +160,7 @@ struct ModuloInstruction : Instruction
 
     void Execute(Device& d) const override
     {
-        std::cout << "Mod value with " << operands.at(0)->get_register_name() << " (" << operands.at(0)->get_value(d.registers) << ") - (" << operands.at(1)->get_value(d.registers) << ") " << std::endl;
+        LOG_TRACE("Mod value with " << operands.at(0)->get_register_name() << " (" << operands.at(0)->get_value(d.registers) << ") - (" << operands.at(1)->get_value(d.registers) << ") ");
         auto& out = d.registers.at(operands.at(0)->get_register_name());
         out = operands.at(0)->get_value(d.registers) % operands.at(1)->get_value(d.registers);
     }
@@ -182,10 +177,10 @@ struct RecoverInstruction : Instruction
     {
         if (0 != d.registers.at(operands.at(0)->get_register_name())) // assumes this is always a register. Observed in puzzle input to be true.
         {
-            std::cout << "RCV: " << d.last_played_sound << "\n";
+            LOG_DEBUG("RCV: " << d.last_played_sound);
         } else
         {
-            std::cout << "zero RCV\n";
+            LOG_DEBUG("zero RCV");
         }
     }
 };
@@ -203,7 +198,7 @@ struct JumpInstruction : Instruction
         const int64_t XValue = operands.at(0)->get_value(d.registers);
         const int64_t YValue = operands.at(1)->get_value(d.registers);
 
-        std::cout << "Jump instruction with " << XValue << " " << YValue << "\n";
+        LOG_TRACE("Jump instruction with " << XValue << " " << YValue);
 
         if (XValue > 0)
         {
@@ -227,7 +222,7 @@ struct ReceiveInstruction : Instruction
         int64_t v = d.receive_queue.front();
         d.receive_queue.pop();
 
-        std::cout << "Receive: " << operands.at(0)->get_register_name() << " (" << v << ") w/ queuesize: " << d.receive_queue.size() << "\n";
+        LOG_TRACE("Receive: " << operands.at(0)->get_register_name() << " (" << v << ") w/ queuesize: " << d.receive_queue.size());
         auto& out = d.registers.at(operands.at(0)->get_register_name());
         out = v;
     }
@@ -242,7 +237,7 @@ struct SendInstruction : Instruction
 
     void Execute(Device& d) const override
     {
-        std::cout << "Send: " << operands.at(0)->get_value(d.registers) << "w/ queuesize: " << d.send_queue.size() << "\n";
+        LOG_TRACE("Send: " << operands.at(0)->get_value(d.registers) << "w/ queuesize: " << d.send_queue.size());
         d.send_queue.push(operands.at(0)->get_value(d.registers));
     }
 };
@@ -266,14 +261,14 @@ constexpr uint64_t operator ""_concat(const char* s, std::size_t n)
 class OperandFactory
 {
 public:
-    static std::unique_ptr<Operand> build(const std::string& op)
+    static std::unique_ptr<Operand> build(std::string_view op)
     {
         if (op.at(0) >= 'a' && op.at(0) <= 'z')
         {
             return std::make_unique<IndirectOperand>(op.at(0));
         } else
         {
-            return std::make_unique<DirectOperand>(std::stoi(op));
+            return std::make_unique<DirectOperand>(Scanner(op).integer());
         }
     }
 };
@@ -281,9 +276,9 @@ public:
 class InstructionFactory
 {
 public:
-    static std::unique_ptr<Instruction> build(const std::string& ins, const std::string& op1, const std::string& op2, bool p2 = false)
+    static std::unique_ptr<Instruction> build(std::string_view ins, std::string_view op1, std::string_view op2, bool p2 = false)
     {
-        switch (operator""_concat(ins.c_str(), ins.size()))
+        switch (operator""_concat(ins.data(), ins.size()))
         {
             case "set"_concat:
                 return std::make_unique<SetInstruction>(OperandFactory::build(op1), OperandFactory::build(op2));
@@ -321,19 +316,17 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
+    void parse(Input &input) override {
 
-        std::string line;
-        while (std::getline(input, line))
+        std::string_view line;
+        while (input.getline(line))
         {
-            std::string ins;
-            std::string opA;
-            std::string opB;
+            Scanner scan(line);
+            std::string_view ins = scan.word();
+            std::string_view opA = scan.word();
+            std::string_view opB = scan.word();
 
-            std::istringstream iss(line);
-            iss >> ins >> opA >> opB;
-
-            std::cout << ins << ", " << opA << ", " << opB << "\n";
+            LOG_DEBUG(ins << ", " << opA << ", " << opB);
             program.emplace_back(InstructionFactory::build(ins, opA, opB));
             p2_program.emplace_back(InstructionFactory::build(ins, opA, opB, true));
         }
@@ -415,8 +408,4 @@ CLASS_DEF(DAY) {
 
 } // namespace
 
-#if QUIET
-#undef cout
-#endif
-
 #undef DAY
\ No newline at end of file
@@ -18,9 +18,9 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        while (std::getline(input, line))
+    void parse(Input &input) override {
+        std::string_view line;
+        while (input.getline(line))
         {
             characters.emplace_back();
             for (auto& c : line)
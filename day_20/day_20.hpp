@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 20
 
@@ -46,53 +47,29 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    // Stream is left pointing to the first character after the XYZ triplet. Assumes pointed-at the start of a triplet.
-    static XYZ extract(std::istringstream& iss)
+    // Scanner is left pointing to the first character after the XYZ triplet. Assumes pointed-at the start of a triplet.
+    static XYZ extract(Scanner& scan)
     {
-        bool minus_flag = false;
-        auto check_minus = [&minus_flag, &iss](){ minus_flag = iss.peek() == '-'; if (minus_flag) iss.get(); };
-        auto apply_minus = [&minus_flag](const int v) { return minus_flag ? -v : v; };
-        
-        int x = 0;
-        check_minus();
-        while (iss.peek() != ',')
-        {
-            x = x * 10 + (iss.get() - '0');
-        }
-        x = apply_minus(x);
-        
-        iss.get();
-        int y = 0;
-        check_minus();
-        while (iss.peek() != ',')
-        {
-            y = y * 10 + (iss.get() - '0');
-        }
-        y = apply_minus(y);
-        
-        iss.get();
-        int z = 0;
-        check_minus();
-        while (iss.peek() != '>')
-        {
-            z = z * 10 + (iss.get() - '0');
-        }
-        z = apply_minus(z);
+        int x = scan.integer();
+        scan.expect(",");
+        int y = scan.integer();
+        scan.expect(",");
+        int z = scan.integer();
 
         return { static_cast<double>(x), static_cast<double>(y), static_cast<double>(z) };
     }
 
-    void parse(std::ifstream &input) override {
-        std::string formula;
-        while (std::getline(input, formula))
+    void parse(Input &input) override {
+        std::string_view formula;
+        while (input.getline(formula))
         {
-            std::istringstream iss(formula);
-            iss.get(); iss.get(); iss.get();
-            XYZ p = extract(iss);
-            iss.get(); iss.get(); iss.get(); iss.get(); iss.get(); iss.get(); // >, v=<
-            XYZ v = extract(iss);
-            iss.get(); iss.get(); iss.get(); iss.get(); iss.get(); iss.get(); // >, a=<
-            XYZ a = extract(iss);
+            Scanner scan(formula);
+            scan.expect("p=<");
+            XYZ p = extract(scan);
+            scan.expect(">, v=<");
+            XYZ v = extract(scan);
+            scan.expect(">, a=<");
+            XYZ a = extract(scan);
 
             points.emplace_back(p, v, a);
         }
@@ -141,9 +118,9 @@ CLASS_DEF(DAY) {
     using CollisionMarker = std::pair<std::pair<int,int>,int>; // first: particle pairs, second: time.
 
     // Approach: solve the quadratic equation for just X, get the natural number times if they exist, fill it in and check if y and z are also matching. Then it is a collision.
-    static std::vector<CollisionMarker> find_collision_times(const PVA& first, const PVA& second, std::pair<int,int> ids)
+    static std::pmr::vector<CollisionMarker> find_collision_times(const PVA& first, const PVA& second, std::pair<int,int> ids)
     {
-        std::vector<double> natural_number_roots;
+        std::pmr::vector<double> natural_number_roots(scratch());
         auto root_qualifies = [](double r) -> bool { return r >= 0 && (static_cast<int64_t>(r) == r); }; // NOLINT(*-narrowing-conversions)
         
         // let's get the A, B, C values for these. First, the formula itself...
@@ -190,7 +167,7 @@ CLASS_DEF(DAY) {
         }
 
         // for the roots that qualified on X... do they qualify on all 3 axes?
-        std::vector<CollisionMarker> true_connections;
+        std::pmr::vector<CollisionMarker> true_connections(scratch());
         for (auto& t : natural_number_roots)
         {
             XYZ p1 = position_at_t(first, t);
@@ -215,7 +192,7 @@ CLASS_DEF(DAY) {
         //   An elimination happens if and only if each of the particles is not destroyed yet at this time.
         //   Keep the multi-collision in mind! Do not eliminate until this (t) is solved. Multiple can crash at the same time!!
 
-        std::vector<CollisionMarker> all_possible_collisions;
+        std::pmr::vector<CollisionMarker> all_possible_collisions(scratch());
         // scuffed upper bound: number of pairs times two. The n_pairs formula division by 2 is cancelled out by the at most 2 solutions per equation pair.
         // Very casual way to just allocate 8M memory, moon lander software team would freak out once again.
         all_possible_collisions.reserve((points.size() * (points.size() - 1)));
@@ -235,23 +212,23 @@ CLASS_DEF(DAY) {
             return cm1.second < cm2.second;
         });
         
-        std::vector<int> time_of_collide(points.size(), -1); // for index i, represents time particle i has collided.
+        std::pmr::vector<int> time_of_collide(points.size(), -1, scratch()); // for index i, represents time particle i has collided.
         auto particle_exists_at_t = [&time_of_collide](int pid, int t) -> bool { return time_of_collide.at(pid) == -1 || time_of_collide.at(pid) >= t; };
 
         for (auto& [particle_pair, t] : all_possible_collisions)
         {
             const auto& [p1, p2] = particle_pair;
 
-            std::cout << p1 << ", " << p2 << " Shall collide at: " << t << "\n";
+            LOG_DEBUG(p1 << ", " << p2 << " Shall collide at: " << t);
             if (particle_exists_at_t(p1, t) && particle_exists_at_t(p2, t))
             {
-                std::cout << "\tAnd it is a problem\n";
+                LOG_DEBUG("\tAnd it is a problem");
                 time_of_collide.at(p1) = t;
                 time_of_collide.at(p2) = t;
             } else
             {
                 // the puzzle input has 0 of these, nice red herring :(
-                std::cout << "\tBut not both exist at this point in time.\n";
+                LOG_DEBUG("\tBut not both exist at this point in time.");
             }
         }
 
@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 21
 
@@ -93,14 +94,11 @@ CLASS_DEF(DAY) {
         // };
     }
 
-    static void get_grid(const int row_size, std::istringstream& scanner, std::vector<bool>& grid) {
-        while (scanner.peek() != ' ' && scanner.peek() != EOF) {
-            for (int n = 0; n < row_size; ++n) {
-                grid.emplace_back(scanner.get() != '.');
-            }
-            
-            if (scanner.peek() == '/') {
-                scanner.get();
+    // 'pattern' is one side of a rule, e.g. "#./.#".
+    static void get_grid(const int row_size, std::string_view pattern, std::vector<bool>& grid) {
+        for (char c : pattern) {
+            if (c != '/') {
+                grid.emplace_back(c != '.');
             }
         }
 
@@ -109,46 +107,28 @@ CLASS_DEF(DAY) {
         }
     }
 
-    static int get_row_size(std::istringstream& scanner) {
-        int row_size = 0;
-        while (scanner.peek() != '/') {
-            ++row_size;
-            scanner.get();
-        }
-
-        return row_size;
+    static int get_row_size(std::string_view pattern) {
+        return static_cast<int>(pattern.find('/'));
     }
 
     // Given one line of input,
     // 1. deduce if it is a 2by2 or 3by3 rule
     // 2. Extract the grid blueprint input and output.
     // 3. insert all rotations and flips into the mapping.
-    void extract_rule(const std::string& rule)
+    void extract_rule(std::string_view rule)
     {
         std::vector<bool> input_grid;
         std::vector<bool> output_grid;
-        int input_row_size = 0;
-        int output_row_size = 0;
-        { // left side row size
-            std::istringstream scanner(rule);
-            input_row_size = get_row_size(scanner);
-        }
-        { // left side grid
-            std::istringstream left_side_scanner(rule);
-            get_grid(input_row_size, left_side_scanner, input_grid);
-        }
-        { // right side size & grid.
-            const int n_skip_input = ((input_row_size + 1) * input_row_size - 1);
-            const int n_skip_center = static_cast<int>(std::string(" => ").size());
-            
-            std::istringstream right_side_scanner(rule);
-            right_side_scanner.seekg(n_skip_input + n_skip_center);
 
-            output_row_size = get_row_size(right_side_scanner);
-            right_side_scanner.seekg(n_skip_input + n_skip_center);
+        Scanner scan(rule);
+        std::string_view left = scan.until(' ');
+        scan.expect("=> ");
+        std::string_view right = scan.rest();
 
-            get_grid(output_row_size, right_side_scanner, output_grid);
-        }
+        const int input_row_size = get_row_size(left);
+        get_grid(input_row_size, left, input_grid);
+        const int output_row_size = get_row_size(right);
+        get_grid(output_row_size, right, output_grid);
 
         int out_value = grid_to_bitmask(output_row_size, output_grid);
 
@@ -163,15 +143,43 @@ CLASS_DEF(DAY) {
         }
     } 
 
-    void parse(std::ifstream &input) override {
-        std::string rule;
-        while (std::getline(input, rule))
+    void parse(Input &input) override {
+        std::string_view rule;
+        while (input.getline(rule))
         {
             extract_rule(rule); // inserts into a std::map every permutation of the input grid to the output grid, as bitmasks.
         }
     }
 
-    void do_growth_step(const std::vector<bool>& in, std::vector<bool>& out) const {
+    // one entry of a rule map, for snapshots.
+    struct Rule {
+        int from;
+        int to;
+    };
+
+    [[nodiscard]] bool hasSnapshotFormat() const override { return true; }
+
+    void save(Snapshot::Writer& out) const override {
+        for (auto* rules : { &two_by_two_rules, &three_by_three_rules }) {
+            std::vector<Rule> flat;
+            flat.reserve(rules->size());
+            for (auto [from, to] : *rules) flat.push_back({ from, to });
+            out.put(std::span<const Rule>(flat));
+        }
+    }
+
+    void load(Snapshot::Reader& in) override {
+        for (auto* rules : { &two_by_two_rules, &three_by_three_rules }) {
+            // saved in key order, so every insert goes at the end.
+            for (auto [from, to] : in.array<Rule>()) rules->emplace_hint(rules->end(), from, to);
+        }
+    }
+
+    // the picture while it grows. Solver scratch, a new one every step.
+    using Grid = std::pmr::vector<bool>;
+
+    void do_growth_step(const Grid& in, Grid& out) const {
+        TRACE_ZONE("growth step");
         const auto in_row_size = static_cast<size_t>(std::sqrt(in.size()));
         const auto out_row_size = static_cast<size_t>(std::sqrt(out.size()));
         
@@ -252,10 +260,10 @@ CLASS_DEF(DAY) {
     }
     
     void v1() const override {
-        std::vector<bool> current = start_pattern;
+        Grid current(start_pattern.begin(), start_pattern.end(), scratch());
 
         for (int i = 0; i < 5; ++i) {
-            std::vector<bool> next(size_of_next(current.size()), false);
+            Grid next(size_of_next(current.size()), false, scratch());
             do_growth_step(current, next);
             
             current = std::move(next);
@@ -270,10 +278,10 @@ CLASS_DEF(DAY) {
     }
 
     void v2() const override {
-        std::vector<bool> current = start_pattern;
+        Grid current(start_pattern.begin(), start_pattern.end(), scratch());
 
         for (int i = 0; i < 18; ++i) {
-            std::vector<bool> next(size_of_next(current.size()), false);
+            Grid next(size_of_next(current.size()), false, scratch());
             do_growth_step(current, next);
             
             current = std::move(next);
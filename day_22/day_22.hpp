@@ -117,12 +117,8 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        std::vector<std::string> lines;
-        while (std::getline(input, line)) {
-            lines.emplace_back(std::move(line));
-        }
+    void parse(Input &input) override {
+        std::vector<std::string_view> lines = input.lines();
 
         size_t grid_length = lines.back().size();
         size_t grid_height = lines.size();
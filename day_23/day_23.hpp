@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 23
 
@@ -55,9 +56,9 @@ struct JumpNotZeroInstruction : Instruction {
 class InstructionFactory
 {
 public:
-    static std::unique_ptr<Instruction> build(const std::string& ins, const std::string& op1, const std::string& op2)
+    static std::unique_ptr<Instruction> build(std::string_view ins, std::string_view op1, std::string_view op2)
     {
-        switch (operator""_concat(ins.c_str(), ins.size()))
+        switch (operator""_concat(ins.data(), ins.size()))
         {
             case "sub"_concat:
                 return std::make_unique<SubtractInstruction>(OperandFactory::build(op1), OperandFactory::build(op2));
@@ -73,16 +74,14 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        while (std::getline(input, line))
+    void parse(Input &input) override {
+        std::string_view line;
+        while (input.getline(line))
         {
-            std::string ins;
-            std::string opA;
-            std::string opB;
-
-            std::istringstream iss(line);
-            iss >> ins >> opA >> opB;
+            Scanner scan(line);
+            std::string_view ins = scan.word();
+            std::string_view opA = scan.word();
+            std::string_view opB = scan.word();
 
             // std::cout << ins << ", " << opA << ", " << opB << "\n";
             program.emplace_back(InstructionFactory::build(ins, opA, opB));
@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 24
 
@@ -20,15 +21,14 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        std::string line;
-        while (std::getline(input, line)) {
-            std::istringstream iss(line);
+    void parse(Input &input) override {
+        std::string_view line;
+        while (input.getline(line)) {
+            Scanner scan(line);
             parts.emplace_back();
-            iss >> parts.back().A;
-            iss.clear();
-            iss.get();
-            iss >> parts.back().B;
+            parts.back().A = scan.integer();
+            scan.expect("/");
+            parts.back().B = scan.integer();
         }
 
         // std::ranges::for_each(parts, [](auto& p) {
@@ -113,14 +113,22 @@ CLASS_DEF(DAY) {
         uint64_t taken_bitmask = 0;
         int connector = 0;
         
-        int best_len = score_all_bridges(taken_bitmask, connector, [](uint64_t b) { return std::popcount(b); });
+        int best_len;
+        {
+            TRACE_ZONE("longest");
+            best_len = score_all_bridges(taken_bitmask, connector, [](uint64_t b) { return std::popcount(b); });
+        }
 
         taken_bitmask = 0; // should be redundant but let's be safe here.
-        int strongest_max_len = score_all_bridges(taken_bitmask, connector, [best_len, this](uint64_t b) -> int {
-            if (std::popcount(b) < best_len) return 0;
-
-            return get_strength_from_mask(b);
-        });
+        int strongest_max_len;
+        {
+            TRACE_ZONE("strongest of the longest");
+            strongest_max_len = score_all_bridges(taken_bitmask, connector, [best_len, this](uint64_t b) -> int {
+                if (std::popcount(b) < best_len) return 0;
+
+                return get_strength_from_mask(b);
+            });
+        }
         
         reportSolution(strongest_max_len);
     }
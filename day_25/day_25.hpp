@@ -4,6 +4,7 @@
 
 #include "../util/Day.hpp"
 #include "../util/macros.hpp"
+#include "../util/Scan.hpp"
 
 #define DAY 25
 
@@ -67,84 +68,49 @@ CLASS_DEF(DAY) {
     public:
     DEFAULT_CTOR_DEF(DAY)
 
-    void parse(std::ifstream &input) override {
-        constexpr std::string_view initial_state_yapping = "Begin in State ";
+    void parse(Input &input) override {
+        constexpr std::string_view initial_state_yapping = "Begin in state ";
         constexpr std::string_view n_steps_input_yapping = "Perform a diagnostic checksum after ";
 
         constexpr std::string_view state_block_yapping =            "In state ";
-        constexpr std::string_view state_block_value_yapping =      "  If the current value is ";
         constexpr std::string_view state_block_write_yapping =      "    - Write the value ";
         constexpr std::string_view state_block_tape_move_yapping =  "    - Move one slot to the ";
         constexpr std::string_view state_block_transition_yapping = "    - Continue with state ";
 
-        auto skip = [](std::istringstream& strm, std::istringstream::off_type skip) { strm.seekg(strm.tellg() + skip); };
-
-        char initial_state;
-        int64_t n_steps;
+        // the line after 'yapping', scanned up to what comes after it.
+        auto line_after = [&input](std::string_view yapping) {
+            std::string_view line;
+            input.getline(line);
+            Scanner scan(line);
+            scan.expect(yapping);
+            return scan;
+        };
+
+        char initial_state = line_after(initial_state_yapping).get();
+        auto n_steps = line_after(n_steps_input_yapping).integer<int64_t>();
         std::vector<State> states;
-        {
-            std::string initial_state_line;
-            std::getline(input, initial_state_line);
-            std::istringstream iss(initial_state_line);
-            skip(iss, initial_state_yapping.size());
-
-            initial_state = static_cast<char>(iss.get());
-        }
-        {
-            std::string n_step_line;
-            std::getline(input, n_step_line);
-            std::istringstream iss(n_step_line);
-            skip(iss, n_steps_input_yapping.size());
 
-            iss >> n_steps;
-        }
-
-        std::string current_line;
-        while (std::getline(input, current_line)) {
+        std::string_view current_line;
+        while (input.getline(current_line)) {
             if (current_line.empty()) {
-                std::string state_line;
                 // this section could be broken up to generify for number of symbols on the tape != 2, but that complicates parsing. I don't want to.
                 int n_states = 2;
                 int i = 0;
-                std::string state;
-                std::string state_write;
-                std::string state_move;
-                std::string state_transition;
 
-                char state_name;
+                char state_name = line_after(state_block_yapping).get();
                 bool state_write_v;
                 bool left_move;
                 char transition_state;
 
-                {
-                    std::getline(input, state_line);
-                    std::istringstream iss(state_line);
-                    skip(iss, state_block_yapping.size());
-                    state_name = static_cast<char>(iss.get());
-                }
                 states.emplace_back(state_name);
 fuck_it_goto_label: // Exceeded the for-loop quota for this year's puzzles, sorry.
                 {
-                    std::getline(input, state);
-                }
-                {
-                    std::getline(input, state_write);
-                    std::istringstream iss(state_write);
-                    skip(iss, state_block_write_yapping.size());
-                    iss >> state_write_v;
-                }
-                {
-                    std::getline(input, state_move);
-                    std::istringstream iss(state_move);
-                    skip(iss, state_block_tape_move_yapping.size());
-                    left_move = iss.get() == 'l';
-                }
-                {
-                    std::getline(input, state_transition);
-                    std::istringstream iss(state_transition);
-                    skip(iss, state_block_transition_yapping.size());
-                    transition_state = static_cast<char>(iss.get());
+                    std::string_view state; // "If the current value is", always in order, so the value is implied by 'i'.
+                    input.getline(state);
                 }
+                state_write_v = line_after(state_block_write_yapping).integer() != 0;
+                left_move = line_after(state_block_tape_move_yapping).get() == 'l';
+                transition_state = line_after(state_block_transition_yapping).get();
 
                 Transition& t = states.back().transitions.at(i);
                 t.write = state_write_v;
@@ -61,32 +61,46 @@
 #include "day_25/day_25.hpp"
 
 namespace DayMap {
-    static const std::map<int, std::function<std::unique_ptr<Day>()>> NtoDay = {
-        { 1, [](){ return std::make_unique<Day1::Day1>(); } },
-        { 2, [](){ return std::make_unique<Day2::Day2>(); } },
-        { 3, [](){ return std::make_unique<Day3::Day3>(); } },
-        { 4, [](){ return std::make_unique<Day4::Day4>(); } },
-        { 5, [](){ return std::make_unique<Day5::Day5>(); } },
-        { 6, [](){ return std::make_unique<Day6::Day6>(); } },
-        { 7, [](){ return std::make_unique<Day7::Day7>(); } },
-        { 8, [](){ return std::make_unique<Day8::Day8>(); } },
-        { 9, [](){ return std::make_unique<Day9::Day9>(); } },
-        { 10,[](){ return std::make_unique<Day10::Day10>(); } },
-        { 11,[](){ return std::make_unique<Day11::Day11>(); } },
-        { 12,[](){ return std::make_unique<Day12::Day12>(); } },
-        { 13,[](){ return std::make_unique<Day13::Day13>(); } },
-        { 14,[](){ return std::make_unique<Day14::Day14>(); } },
-        { 15,[](){ return std::make_unique<Day15::Day15>(); } },
-        { 16,[](){ return std::make_unique<Day16::Day16>(); } },
-        { 17,[](){ return std::make_unique<Day17::Day17>(); } },
-        { 18,[](){ return std::make_unique<Day18::Day18>(); } },
-        { 19,[](){ return std::make_unique<Day19::Day19>(); } },
-        { 20,[](){ return std::make_unique<Day20::Day20>(); } },
-        { 21,[](){ return std::make_unique<Day21::Day21>(); } },
-        { 22,[](){ return std::make_unique<Day22::Day22>(); } },
-        { 23,[](){ return std::make_unique<Day23::Day23>(); } },
-        { 24,[](){ return std::make_unique<Day24::Day24>(); } },
-        { 25,[](){ return std::make_unique<Day25::Day25>(); } },
+    struct Factory {
+        std::function<std::unique_ptr<Day>()> make; // over the day's own input file.
+        std::function<std::unique_ptr<Day>(const std::string&)> withInput; // over another, relative to the root unless absolute.
+        std::function<std::unique_ptr<Day>(MappedFile)> withData; // over input that is already in memory.
+    };
+
+    template<typename D> Factory factory() {
+        return {
+            [](){ return std::make_unique<D>(); },
+            [](const std::string& inputFilePath){ return std::make_unique<D>(inputFilePath); },
+            [](MappedFile input){ return std::make_unique<D>(std::move(input)); },
+        };
+    }
+
+    static const std::map<int, Factory> NtoDay = {
+        { 1,  factory<Day1::Day1>() },
+        { 2,  factory<Day2::Day2>() },
+        { 3,  factory<Day3::Day3>() },
+        { 4,  factory<Day4::Day4>() },
+        { 5,  factory<Day5::Day5>() },
+        { 6,  factory<Day6::Day6>() },
+        { 7,  factory<Day7::Day7>() },
+        { 8,  factory<Day8::Day8>() },
+        { 9,  factory<Day9::Day9>() },
+        { 10, factory<Day10::Day10>() },
+        { 11, factory<Day11::Day11>() },
+        { 12, factory<Day12::Day12>() },
+        { 13, factory<Day13::Day13>() },
+        { 14, factory<Day14::Day14>() },
+        { 15, factory<Day15::Day15>() },
+        { 16, factory<Day16::Day16>() },
+        { 17, factory<Day17::Day17>() },
+        { 18, factory<Day18::Day18>() },
+        { 19, factory<Day19::Day19>() },
+        { 20, factory<Day20::Day20>() },
+        { 21, factory<Day21::Day21>() },
+        { 22, factory<Day22::Day22>() },
+        { 23, factory<Day23::Day23>() },
+        { 24, factory<Day24::Day24>() },
+        { 25, factory<Day25::Day25>() },
     };
 
     inline auto get(int n) {
@@ -96,7 +110,27 @@ namespace DayMap {
             throw std::logic_error(std::to_string(n) + ": This day is not valid.");
         }
 
-        return iter->second();
+        return iter->second.make();
+    }
+
+    inline auto get(int n, const std::string& inputFilePath) {
+        auto iter = NtoDay.find(n);
+
+        if (iter == NtoDay.end()) {
+            throw std::logic_error(std::to_string(n) + ": This day is not valid.");
+        }
+
+        return iter->second.withInput(inputFilePath);
+    }
+
+    inline auto get(int n, MappedFile input) {
+        auto iter = NtoDay.find(n);
+
+        if (iter == NtoDay.end()) {
+            throw std::logic_error(std::to_string(n) + ": This day is not valid.");
+        }
+
+        return iter->second.withData(std::move(input));
     }
 }
 
@@ -2,40 +2,246 @@
 #include <memory>
 #include <map>
 #include <set>
+#include <iomanip>
+#include <fstream>
+#include <csignal>
+#include <future>
+#include <cmath>
+#include <sstream>
+#include <vector>
 
 #include "day_defs.hpp"
+#include "util/Args.hpp"
+#include "util/ThreadPool.hpp"
+#include "util/Report.hpp"
+#include "util/Isolate.hpp"
+#include "util/Serve.hpp"
+#include "util/ResultCache.hpp"
+#include "util/Generate.hpp"
+#include "util/Scaling.hpp"
+#include "util/Parallel.hpp"
+#include "util/Golden.hpp"
 
 enum class ExitCodes {
     OK = 0,
     NO_INPUT = -1,
     BAD_INPUT = -2,
+    REGRESSION = -3,
+    CACHE_MISMATCH = -4,
+    WRONG_ANSWER = -5,
 };
 
-int benchEverything();
+int benchEverything(const Args& args, const BenchConfig& config);
+int compareToBaseline(const Args& args);
+int solveBatch(const Args& args);
+int generate(const Args& args);
+int scaleCurves(const Args& args, int day);
+int serve(const Args& args);
+int solveCached(const Args& args, int day, Day& solver);
+int solveEverything(const Args& args);
+
+// --warmup N, --budget seconds (per phase), --rse X (e.g. 0.01 to stop once the mean is known to within ~1%),
+// --batch-target ns (minimum time per sample for fast phases, 0 to time every call on its own), --counters (hardware counters),
+// --allocs (heap allocations per call), --streaming (constant memory stats, approximate percentiles),
+// --cold (evict caches before every sample) with --cold-tlb, --cold-branches and --cold-mb N (eviction buffer size),
+// --expect-v1 / --expect-v2 answer (check every sample's answer, see expecting() for taking them from a golden file).
+BenchConfig benchConfigFrom(const Args& args, BenchConfig config) {
+    config.warmup = args.get("warmup", config.warmup);
+    if (args.has("budget")) {
+        config.budget = chrono::duration<double>(args.get("budget", 0.0));
+    }
+    config.targetRse = args.get("rse", config.targetRse);
+    config.batchTarget = chrono::nanoseconds{args.get("batch-target", static_cast<int>(config.batchTarget.count()))};
+    config.counters = config.counters || args.has("counters");
+    config.allocations = config.allocations || args.has("allocs");
+    config.streaming = config.streaming || args.has("streaming");
+    config.cold = config.cold || args.has("cold");
+    config.coldTlb = config.coldTlb || args.has("cold-tlb");
+    config.coldBranches = config.coldBranches || args.has("cold-branches");
+    config.coldBytes = static_cast<size_t>(args.get("cold-mb", static_cast<int>(config.coldBytes >> 20))) << 20;
+    if (args.has("expect-v1")) config.expected[0] = args.get("expect-v1", std::string());
+    if (args.has("expect-v2")) config.expected[1] = args.get("expect-v2", std::string());
+    return config;
+}
+
+// 'config', checking the answers of 'day' against 'golden' where it has them.
+BenchConfig expecting(BenchConfig config, const std::optional<Golden>& golden, int day) {
+    if (! golden) return config;
+    for (int part : { 1, 2 }) {
+        if (auto answer = golden->expected(day, part)) config.expected[part - 1] = std::move(answer);
+    }
+    return config;
+}
+
+std::optional<Golden> goldenFrom(const Args& args) {
+    if (! args.has("golden")) return std::nullopt;
+    return Golden(args.get("golden", std::string()));
+}
+
+// the phases that got a wrong answer in any sample, printed. True if there were none.
+bool allAnswersRight(const std::vector<Report::Entry>& entries) {
+    bool right = true;
+    for (auto& [day, phase, s] : entries) {
+        if (s->wrong_answers() == 0) continue;
+        std::cout << "Day " << day << " " << phase << ": wrong answer in " << s->wrong_answers() << " of " << s->answers_verified()
+                  << " samples, e.g. " << s->first_wrong_answer() << "\n";
+        right = false;
+    }
+    return right;
+}
+
+// the flags that make benchConfigFrom() give back 'config', except for the sample count. To hand a config to a worker process.
+std::vector<std::string> benchConfigArgs(const BenchConfig& config) {
+    auto exact = [](double d) {
+        std::ostringstream s;
+        s.precision(17);
+        s << d;
+        return s.str();
+    };
+
+    std::vector<std::string> result {
+        "--warmup", std::to_string(config.warmup),
+        "--rse", exact(config.targetRse),
+        "--batch-target", std::to_string(config.batchTarget.count()),
+    };
+    if (config.budget != chrono::duration<double>::max()) {
+        result.insert(result.end(), { "--budget", exact(config.budget.count()) });
+    }
+    if (config.counters) result.emplace_back("--counters");
+    if (config.allocations) result.emplace_back("--allocs");
+    if (config.streaming) result.emplace_back("--streaming");
+    if (config.cold) result.emplace_back("--cold");
+    if (config.coldTlb) result.emplace_back("--cold-tlb");
+    if (config.coldBranches) result.emplace_back("--cold-branches");
+    if (config.coldBytes > 0) result.insert(result.end(), { "--cold-mb", std::to_string(config.coldBytes >> 20) });
+    if (config.expected[0]) result.insert(result.end(), { "--expect-v1", *config.expected[0] });
+    if (config.expected[1]) result.insert(result.end(), { "--expect-v2", *config.expected[1] });
+    return result;
+}
+
+// the warm and cold distribution of each phase next to each other, and how much slower cold is.
+void printWarmCold(const Day::StatTriplet& warm, const Day::StatTriplet& cold) {
+    static const char* phases[] = { "parse", "v1", "v2" };
+    auto distribution = [](const BenchmarkStats& b) {
+        return b.format(b.nth_ile(0.5)) + " / " + b.format(b.nth_ile(0.9)) + " / " + b.format(b.nth_ile(0.99));
+    };
+
+    std::cout << std::left << std::setw(8) << "phase" << std::setw(32) << "warm p50 / p90 / p99" << std::setw(32) << "cold p50 / p90 / p99" << "cold / warm (p50)\n";
+    for (int i = 0; i < 3; ++i) {
+        double ratio = warm[i].median().count() > 0 ? static_cast<double>(cold[i].median().count()) / static_cast<double>(warm[i].median().count()) : 0;
+        std::cout << std::setw(8) << phases[i] << std::setw(32) << distribution(warm[i]) << std::setw(32) << distribution(cold[i]) << std::round(ratio * 100) / 100 << "x\n";
+    }
+    std::cout << std::right;
+}
+
+// per phase, the median at each thread count, and how it compares to one thread.
+void printThreadSweep(const std::vector<int>& counts, const std::vector<Day::StatTriplet>& sweep) {
+    static const char* phases[] = { "parse", "v1", "v2" };
+    std::cout << std::left << std::setw(8) << "phase" << std::setw(10) << "threads" << std::setw(14) << "p50"
+              << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << "serial fraction (Karp-Flatt)\n";
+    for (int i = 0; i < 3; ++i) {
+        const auto t1 = static_cast<double>(sweep.front()[i].median().count());
+        for (size_t k = 0; k < counts.size(); ++k) {
+            auto& s = sweep[k][i];
+            auto e = Parallel::of(t1, static_cast<double>(s.median().count()), counts[k]);
+            std::cout << std::setw(8) << (k == 0 ? phases[i] : "") << std::setw(10) << counts[k] << std::setw(14) << s.format(s.median())
+                      << std::fixed << std::setprecision(2) << std::setw(10) << e.speedup << std::setw(12) << e.efficiency;
+            if (counts[k] > 1) std::cout << std::setprecision(3) << e.serialFraction;
+            std::cout << std::defaultfloat << std::setprecision(6) << "\n";
+        }
+    }
+    std::cout << std::right;
+}
 
 int main(int argc, char** argv) {
-    if (argc < 3) {
-        std::cout << "Require input: [solve|bench|bench_all] [dayNumber] (bench_sample_size)\n";
+    Args args(argc, argv);
+
+    if (args.size() < 2) {
+        std::cout << "Require input: [root] [solve|bench|bench_all] [dayNumber] (bench_sample_size) (--jobs N) (--fork|--isolate fork|exec) (--isolate-phases) (--warmup N) (--budget seconds) (--rse X) (--batch-target ns) (--counters) (--allocs) (--streaming) (--cold) (--cold-tlb) (--cold-branches) (--cold-mb N) (--thread-sweep) (--max-threads N) (--golden path) (--expect-v1 answer) (--expect-v2 answer) (--json path) (--csv path)\n";
+        std::cout << "           or: [root] solve [dayNumber] (--log off|error|info|debug|trace) (--no-cache|--verify) (--cache-dir path) (--sequential) (--snapshot)\n";
+        std::cout << "           or: [root] solve_all (--jobs N) (--snapshot)\n";
+        std::cout << "           or: [root] trace [dayNumber] (--out trace.json)\n";
+        std::cout << "           or: [root] serve (--socket path) (--jobs N) (--cache N)\n";
+        std::cout << "           or: [root] solve_batch [dayNumber] [directory] (--jobs N) (--out results.jsonl)\n";
+        std::cout << "           or: [root] generate [dayNumber] [scale] [seed] (--out path)\n";
+        std::cout << "           or: [root] scale [dayNumber] (--from N) (--to N) (--factor F) (--seed S) (--phase parse|v1|v2) (--budget seconds) (--json path) (--csv path)\n";
+        std::cout << "           or: [root] compare [baseline.json] [current.json] (--alpha p) (--min-change fraction)\n";
         return static_cast<int>(ExitCodes::NO_INPUT);
     }
 
-    Day::setRoot(argv[1]);
-    std::string mode = argv[2];
+    Day::setRoot(args[0]);
+    // parsed state is mapped in from <input>.snap where a day has a snapshot format, see Snapshot. Written on first use.
+    Day::setSnapshots(args.has("snapshot"));
+    std::string mode = args[1];
+
+    // diagnostics only make sense when solving. In a benchmark they would be measured too, and printed thousands of times.
+    // Only what the build compiled in (AOC_LOG_LEVEL) can be turned on here.
+    Log::setLevel(mode == "solve" ? Log::parseLevel(args.get("log", "info")) : Log::Level::OFF);
 
     if (mode == "bench_all") {
         std::cout << "bench all call.\n";
-        return benchEverything();
+        // Without a budget, a full run would spend the better part of a week on day 22 alone.
+        BenchConfig defaults;
+        defaults.budget = chrono::seconds{10};
+        return benchEverything(args, benchConfigFrom(args, defaults));
     }
 
-    if (argc < 4) {
+    if (mode == "compare") {
+        if (args.size() < 4) {
+            std::cout << "Require a baseline and a current result file (json)\n";
+            return static_cast<int>(ExitCodes::NO_INPUT);
+        }
+        return compareToBaseline(args);
+    }
+
+    if (mode == "solve_all") {
+        return solveEverything(args);
+    }
+
+    if (mode == "serve") {
+        return serve(args);
+    }
+
+    if (args.size() < 3) {
         std::cout << "Require day number (int)\n";
         return static_cast<int>(ExitCodes::NO_INPUT);
     }
 
-    int day = std::stoi(argv[3]);
+    if (mode == "solve_batch") {
+        if (args.size() < 4) {
+            std::cout << "Require a day number and a directory of inputs\n";
+            return static_cast<int>(ExitCodes::NO_INPUT);
+        }
+        return solveBatch(args);
+    }
+
+    if (mode == "generate") {
+        if (args.size() < 5) {
+            std::cout << "Require a day number, a scale and a seed\n";
+            return static_cast<int>(ExitCodes::NO_INPUT);
+        }
+        return generate(args);
+    }
+
+    int day = std::stoi(args[2]);
+
+    // a process started by bench_all --isolate exec: [root] worker [day] [samples] (--phase 0|1|2) --result-fd N, and the config flags.
+    // Benchmarks silently and sends the stats to the parent, see Isolate.
+    if (mode == "worker") {
+        BenchConfig config = benchConfigFrom(args, {});
+        config.maxSamples = std::stoi(args[3]);
+        config.reportEveryPct = 0.0;
+        Day::StatTriplet stats;
+        DayMap::get(day)->benchmark(stats, config, false, args.get("phase", -1));
+        return Isolate::send(args.get("result-fd", -1), day, stats) ? static_cast<int>(ExitCodes::OK) : static_cast<int>(ExitCodes::BAD_INPUT);
+    }
 
     std::cout << mode << " day " << day << "\n";
 
+    if (mode == "scale") {
+        return scaleCurves(args, day);
+    }
+
     // looking up a day that does not exist will cause std::bad_function_call to be thrown,
     // because operator[] creates a new default-initialized value if the key is not found.
     // looking up a day that is not implemented will cause std::logic_error to be thrown,
@@ -43,12 +249,71 @@ int main(int argc, char** argv) {
     auto solver = DayMap::get(day);
 
     if (mode == "solve") {
+        if (args.has("no-cache")) {
+            solver->solve(! args.has("sequential"));
+        } else {
+            return solveCached(args, day, *solver);
+        }
+    } else if (mode == "trace") {
+        // solves once with the TRACE_ZONEs recording, and writes them for chrome://tracing or Perfetto.
+        if (! Trace::compiled()) {
+            std::cout << "Tracing is not compiled in, configure with -DAOC_TRACING=ON\n";
+            return static_cast<int>(ExitCodes::BAD_INPUT);
+        }
+        Trace::setEnabled(true);
         solver->solve();
+        Trace::setEnabled(false);
+
+        auto path = args.get("out", std::string("trace.json"));
+        std::ofstream out(path);
+        if (! out) throw std::invalid_argument("could not write: " + path);
+        Trace::writeChrome(out);
+        std::cout << "trace written to " << path;
+        if (auto lost = Trace::dropped()) std::cout << " (" << lost << " oldest events overwritten)";
+        std::cout << "\n";
     } else if (mode == "bench") {
-        if (argc > 4) {
-            solver->benchmark(std::stoi(argv[4]));
+        BenchConfig config = expecting(benchConfigFrom(args, {}), goldenFrom(args), day);
+        if (args.size() > 3) {
+            config.maxSamples = std::stoi(args[3]);
+        }
+        if (args.has("thread-sweep")) {
+            // every phase again with 1, 2, 4, ... OpenMP threads, up to the core count or --max-threads. Exported as e.g. "v1_t4".
+            const auto counts = Parallel::threadCounts(args.get("max-threads", Parallel::cores()));
+            const int before = Parallel::threads();
+            std::vector<Day::StatTriplet> sweep(counts.size());
+            std::vector<Report::Entry> entries;
+            for (size_t k = 0; k < counts.size(); ++k) {
+                Parallel::setThreads(counts[k]);
+                solver->benchmark(sweep[k], config, false);
+                for (int i = 0; i < 3; ++i) {
+                    static const char* phases[] = { "parse", "v1", "v2" };
+                    entries.push_back({ day, std::string(phases[i]) + "_t" + std::to_string(counts[k]), &sweep[k][i] });
+                }
+            }
+            Parallel::setThreads(before);
+            printThreadSweep(counts, sweep);
+            Report::write(entries, args.get("json", ""), args.get("csv", ""));
+            if (! allAnswersRight(entries)) return static_cast<int>(ExitCodes::WRONG_ANSWER);
+        } else if (config.cold) {
+            // the same phases warm, then cold, so the two can be compared. Exported as e.g. "v1" and "v1_cold".
+            BenchConfig warmConfig = config;
+            warmConfig.cold = false;
+            Day::StatTriplet warm, cold;
+            solver->benchmark(warm, warmConfig, false);
+            solver->benchmark(cold, config, false);
+            printWarmCold(warm, cold);
+            std::vector<Report::Entry> entries {
+                { day, "parse", &warm[0] }, { day, "v1", &warm[1] }, { day, "v2", &warm[2] },
+                { day, "parse_cold", &cold[0] }, { day, "v1_cold", &cold[1] }, { day, "v2_cold", &cold[2] },
+            };
+            Report::write(entries, args.get("json", ""), args.get("csv", ""));
+            if (! allAnswersRight(entries)) return static_cast<int>(ExitCodes::WRONG_ANSWER);
         } else {
-            solver->benchmark();
+            Day::StatTriplet stats;
+            solver->benchmark(stats, config, true);
+            std::vector<Report::Entry> entries { { day, "parse", &stats[0] }, { day, "v1", &stats[1] }, { day, "v2", &stats[2] } };
+            Report::write(entries, args.get("json", ""), args.get("csv", ""));
+            if (! allAnswersRight(entries)) return static_cast<int>(ExitCodes::WRONG_ANSWER);
         }
     } else {
         std::cout << "unknown mode '" << mode << "'\n";
@@ -58,10 +323,28 @@ int main(int argc, char** argv) {
     return static_cast<int>(ExitCodes::OK);
 }
 
-// Runs every day in sequence and gets performance stats for each. You cannot use this until all days are implemented.
-int benchEverything() {
+// Runs every day and gets performance stats for each. You cannot use this until all days are implemented.
+// With jobs > 1, days are farmed out to a pool of worker threads (pinned to separate physical cores if there are enough),
+// longest-expected-first, so the whole run takes about as long as the slowest day instead of the sum of all of them.
+// 'config' applies to every day, except that its sample count is only the default and may be overridden per day below.
+// --isolate fork|exec runs each day in a child process of its own, so one day's heap and peak RSS do not carry over into the next,
+// and the numbers do not depend on which days ran before. --fork is short for --isolate fork. --isolate-phases goes further,
+// with a process per phase. Isolated workers are pinned to a core, the first one if sequential, their worker thread's if not.
+// --golden path checks every sample's answer against a solve_all output, and exits with WRONG_ANSWER if any was off.
+int benchEverything(const Args& args, const BenchConfig& config) {
+    const int jobs = args.get("jobs", 1);
+    const auto isolation = args.has("fork") ? Isolate::Mode::FORK : Isolate::parseMode(args.get("isolate", "none"));
+    const bool perPhase = args.has("isolate-phases");
+    if (isolation != Isolate::Mode::NONE && config.streaming) {
+        throw std::invalid_argument("--isolate sends the samples back to the parent, so it cannot be combined with --streaming");
+    }
+    if (perPhase && isolation == Isolate::Mode::NONE) {
+        throw std::invalid_argument("--isolate-phases needs --isolate fork or exec");
+    }
+    const std::string root = args[0];
+    const auto golden = goldenFrom(args);
     std::vector<std::array<BenchmarkStats, 3>> stats(DayMap::NtoDay.size());
-    int defaultSampleSize = 10000;
+    int defaultSampleSize = config.maxSamples;
 
     static const std::map<int, int> sampleSizeOverrides {
         // {3, 1000}, // example: hardcoded adjusted sampling for if your solution would be too slow with the default.
@@ -79,23 +362,481 @@ int benchEverything() {
         return defaultSampleSize;
     };
 
-    int i = 1;
+    // Seconds per sample of parse + v1 + v2, from performance.txt. Only used to order the work, so it does not need to be precise.
+    static const std::map<int, double> expectedSecondsPerSample {
+        { 1, 204e-6 }, { 2, 367e-6 }, { 3, 579e-6 }, { 4, 1.24e-3 }, { 5, 4.31e-3 },
+        { 6, 42.1e-3 }, { 7, 17.3e-3 }, { 8, 78.6e-6 }, { 9, 37.6e-3 }, { 10, 1.19e-3 },
+        { 11, 39.2e-3 }, { 12, 29.5e-3 }, { 13, 5.42 }, { 14, 177e-6 }, { 15, 533e-6 },
+        { 16, 140e-3 }, { 17, 212e-6 }, { 18, 3.10 }, { 19, 25.7e-3 }, { 20, 286e-3 },
+        { 21, 3.7e-6 }, { 22, 74.7 }, { 23, 2.79 }, { 24, 34.4e-3 }, { 25, 297e-6 },
+    };
+
+    struct Job {
+        int index; // into 'stats', i.e. the position of the day in DayMap::NtoDay.
+        int day;
+        int sampleCount;
+        double expectedSeconds;
+    };
+
+    std::vector<Job> work;
+    int i = 0;
     for (auto& [day, ctor] : DayMap::NtoDay) {
-        // run benchmark with the specified sample count and less reporting on prints, do not cout resulting stat objects.
         int sampleCount = getSampleSize(day);
-        std::cout << "Day " << day << ". (" << sampleCount << "x)\n";
-        ctor()->benchmark(stats[i-1], sampleCount, 0.10, false);
+        auto iter = expectedSecondsPerSample.find(day);
+        double perSample = iter == expectedSecondsPerSample.end() ? 0.0 : iter->second;
+        work.push_back({ i, day, sampleCount, perSample * sampleCount });
         i++;
     }
 
+    // 'cpu' is where an isolated worker is pinned, if not negative.
+    const bool snapshots = args.has("snapshot");
+    auto benchDay = [isolation, perPhase, snapshots, &root](int day, const BenchConfig& dayConfig, Day::StatTriplet& out, int cpu) {
+        if (isolation == Isolate::Mode::NONE) {
+            DayMap::get(day)->benchmark(out, dayConfig, false);
+            return;
+        }
+
+        for (int phase : perPhase ? std::vector { 0, 1, 2 } : std::vector { -1 }) {
+            if (isolation == Isolate::Mode::FORK) {
+                Isolate::forked(day, [&](Day::StatTriplet& stats) { DayMap::get(day)->benchmark(stats, dayConfig, false, phase); }, cpu, out);
+            } else {
+                std::vector<std::string> worker { root, "worker", std::to_string(day), std::to_string(dayConfig.maxSamples), "--phase", std::to_string(phase) };
+                auto flags = benchConfigArgs(dayConfig);
+                worker.insert(worker.end(), flags.begin(), flags.end());
+                if (snapshots) worker.emplace_back("--snapshot"); // not part of BenchConfig: Day::setSnapshots is global.
+                Isolate::executed(worker, cpu, out);
+            }
+        }
+    };
+    const int firstCore = isolation == Isolate::Mode::NONE ? -1 : Affinity::physicalCores().front();
+
+    if (jobs <= 1) {
+        for (auto& job : work) {
+            // run benchmark with the specified sample count and less reporting on prints, do not cout resulting stat objects.
+            std::cout << "Day " << job.day << ". (" << job.sampleCount << "x)\n";
+            BenchConfig dayConfig = expecting(config, golden, job.day);
+            dayConfig.maxSamples = job.sampleCount;
+            dayConfig.reportEveryPct = 0.10;
+            benchDay(job.day, dayConfig, stats[job.index], firstCore);
+        }
+    } else {
+        std::ranges::stable_sort(work, std::greater{}, &Job::expectedSeconds);
+
+        // Two workers on the same core would measure each other. Only pin if every worker can get a core of its own.
+        auto cores = Affinity::physicalCores();
+        if (static_cast<size_t>(jobs) > cores.size()) {
+            std::cout << "Warning: " << jobs << " jobs but only " << cores.size() << " physical cores. Workers will not be pinned.\n";
+            cores.clear();
+        }
+
+        std::mutex print_mutex;
+        ThreadPool pool(jobs, cores);
+        for (auto& job : work) {
+            pool.submit([&stats, &print_mutex, &config, &golden, &benchDay, isolation, job]() {
+                {
+                    std::lock_guard lock(print_mutex);
+                    std::cout << "Day " << job.day << " started. (" << job.sampleCount << "x)\n";
+                }
+                // progress reports from concurrent days would interleave into garbage, so run silently.
+                BenchConfig dayConfig = expecting(config, golden, job.day);
+                dayConfig.maxSamples = job.sampleCount;
+                dayConfig.reportEveryPct = 0.0;
+                dayConfig.phasePeakRss = isolation != Isolate::Mode::NONE;
+                benchDay(job.day, dayConfig, stats[job.index], -1); // inherits the pinning of this worker thread.
+                {
+                    std::lock_guard lock(print_mutex);
+                    std::cout << "Day " << job.day << " done.\n";
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    // only mention why sampling stopped if it was not simply because the requested count was reached, keeps the table diffable against older runs.
+    auto stopNote = [](const BenchmarkStats& b) -> std::string {
+        if (b.stopped_because() == BenchmarkStats::StopReason::SAMPLE_COUNT) return "";
+        return " (" + b.stop_description() + ")";
+    };
+
     i = 1;
     for (auto& statblock : stats) {
         auto& [parse, v1, v2] = statblock;
-        std::cout << "Day " << i << " parse mean (median): " << parse.format(parse.mean()) << " (" << parse.format(parse.median()) << "). Sample Size: " << parse.n_samples() << "\n";
-        std::cout << "Day " << i << " part 1 mean (median): " << v1.format(v1.mean()) << " (" << v1.format(v1.median()) << "). Sample Size: " << v1.n_samples() << "\n";
-        std::cout << "Day " << i << " part 2 mean (median): " << v2.format(v2.mean()) << " (" << v2.format(v2.median()) << "). Sample Size: " << v2.n_samples() << "\n";
+        std::cout << "Day " << i << " parse mean (median): " << parse.format(parse.mean()) << " (" << parse.format(parse.median()) << "). Sample Size: " << parse.n_samples() << stopNote(parse) << "\n";
+        std::cout << "Day " << i << " part 1 mean (median): " << v1.format(v1.mean()) << " (" << v1.format(v1.median()) << "). Sample Size: " << v1.n_samples() << stopNote(v1) << "\n";
+        std::cout << "Day " << i << " part 2 mean (median): " << v2.format(v2.mean()) << " (" << v2.format(v2.median()) << "). Sample Size: " << v2.n_samples() << stopNote(v2) << "\n";
+        if (parse.has_memory()) {
+            auto mb = [](const BenchmarkStats& b) { return std::round(static_cast<double>(b.memory().peak_rss_kb) / 102.4) / 10; };
+            std::cout << "Day " << i << " peak RSS parse / part 1 / part 2: " << mb(parse) << " / " << mb(v1) << " / " << mb(v2) << " MB"
+                      << (parse.memory().peak_is_phase ? "" : " (process)") << ". Page faults: "
+                      << parse.memory().faults.minor << " / " << v1.memory().faults.minor << " / " << v2.memory().faults.minor << "\n";
+        }
         i++;
     }
 
+    std::vector<Report::Entry> entries;
+    i = 1;
+    for (auto& [parse, v1, v2] : stats) {
+        entries.push_back({ i, "parse", &parse });
+        entries.push_back({ i, "v1", &v1 });
+        entries.push_back({ i, "v2", &v2 });
+        i++;
+    }
+    Report::write(entries, args.get("json", ""), args.get("csv", ""));
+
+    return static_cast<int>(allAnswersRight(entries) ? ExitCodes::OK : ExitCodes::WRONG_ANSWER);
+}
+
+// Loads two --json exports and lists every phase that got slower. Exits with REGRESSION if any did so significantly.
+int compareToBaseline(const Args& args) {
+    const double alpha = args.get("alpha", 0.01);
+    const double minChange = args.get("min-change", 0.02);
+
+    auto baseline = Report::load(args[2]);
+    auto current = Report::load(args[3]);
+    std::cout << "baseline: " << baseline["meta"]["revision"].string() << " (" << baseline["meta"]["timestamp"].string() << ")\n";
+    std::cout << "current:  " << current["meta"]["revision"].string() << " (" << current["meta"]["timestamp"].string() << ")\n";
+
+    int regressions = 0;
+    for (auto& c : Report::compare(baseline, current, alpha, minChange)) {
+        double change = c.baselineMedian > 0 ? (c.currentMedian / c.baselineMedian - 1) * 100 : 0;
+        std::cout << "Day " << c.day << " " << c.phase << ": median " << c.baselineMedian << " ns -> " << c.currentMedian << " ns ("
+                  << (change >= 0 ? "+" : "") << change << "%), p = " << c.pValue << (c.regression ? "  REGRESSION" : "") << "\n";
+        regressions += c.regression;
+    }
+
+    std::cout << regressions << " regression(s) at alpha " << alpha << ", minimum change " << (minChange * 100) << "%\n";
+    return static_cast<int>(regressions > 0 ? ExitCodes::REGRESSION : ExitCodes::OK);
+}
+// Solves every file in a directory as input for one day, on a thread pool, and writes one JSON line per input,
+// in file name order: {"input", "v1", "v2", "ms"}, or {"input", "error"} if the solver threw.
+// Lines go out as soon as every input before them is done. Throughput and latency percentiles go to stderr at the end,
+// so stdout (without --out) is nothing but the results.
+int solveBatch(const Args& args) {
+    const int day = std::stoi(args[2]);
+    const int jobs = std::max(1, args.get("jobs", static_cast<int>(std::thread::hardware_concurrency())));
+    DayMap::get(day); // fail on a bad day number before doing anything else.
+
+    std::vector<std::string> inputs;
+    for (auto& entry : std::filesystem::directory_iterator(args[3])) {
+        if (! entry.is_regular_file() || Snapshot::isSnapshot(entry.path())) continue; // --snapshot writes those next to the inputs.
+        inputs.push_back(std::filesystem::absolute(entry.path()).string()); // absolute, or Day would look under the root.
+    }
+    std::ranges::sort(inputs);
+
+    std::ofstream file;
+    if (args.has("out")) {
+        file.open(args.get("out", std::string()));
+        if (! file) throw std::invalid_argument("could not write: " + args.get("out", std::string()));
+    }
+    std::ostream& out = args.has("out") ? file : std::cout;
+
+    std::vector<std::optional<std::string>> lines(inputs.size());
+    size_t nextToWrite = 0;
+    std::mutex lines_mutex;
+    BenchmarkStats latency(std::chrono::milliseconds{1});
+    latency.reserve(static_cast<int>(inputs.size()));
+
+    const auto start = chrono::steady_clock::now();
+    {
+        ThreadPool pool(jobs);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            pool.submit([&, i]() {
+                const auto& input = inputs[i];
+                const auto begin = chrono::steady_clock::now();
+                std::string line = "{\"input\": " + Json::quote(input);
+                try {
+                    auto answers = DayMap::get(day, input)->answers();
+                    const auto took = chrono::duration<double, std::milli>(chrono::steady_clock::now() - begin);
+                    line += ", \"v1\": " + Json::quote(answers.v1) + ", \"v2\": " + Json::quote(answers.v2) + ", \"ms\": " + std::to_string(took.count()) + "}";
+                } catch (const std::exception& e) {
+                    line += ", \"error\": " + Json::quote(e.what()) + "}";
+                }
+                const auto took = chrono::steady_clock::now() - begin;
+
+                std::lock_guard lock(lines_mutex);
+                latency.measurement(took);
+                lines[i] = std::move(line);
+                for (; nextToWrite < lines.size() && lines[nextToWrite]; ++nextToWrite) {
+                    out << *lines[nextToWrite] << "\n";
+                    lines[nextToWrite].reset();
+                }
+            });
+        }
+        pool.wait();
+    }
+    out.flush();
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    std::cerr << inputs.size() << " inputs in " << elapsed.count() << " s on " << jobs << " threads: "
+              << (static_cast<double>(inputs.size()) / elapsed.count()) << " inputs/s";
+    if (latency.n_samples() > 0) {
+        std::cerr << ", latency p50 / p99: " << latency.format(latency.nth_ile(0.5)) << " / " << latency.format(latency.nth_ile(0.99));
+    }
+    std::cerr << "\n";
+    return static_cast<int>(ExitCodes::OK);
+}
+
+// Answers requests for as long as they keep coming, keeping parsed inputs around so a repeated question skips parsing. See Serve.
+// On stdin/stdout until end of input, or with --socket, on a Unix domain socket with any number of clients, until killed.
+// --cache bounds how many parsed inputs are kept.
+int serve(const Args& args) {
+    const int jobs = std::max(1, args.get("jobs", static_cast<int>(std::thread::hardware_concurrency())));
+    SolverCache cache([](int day, MappedFile input) { return DayMap::get(day, std::move(input)); }, args.get("cache", 64));
+    ThreadPool pool(jobs);
+    signal(SIGPIPE, SIG_IGN); // a client that hangs up early must not take the daemon down with it.
+
+    if (! args.has("socket")) {
+        Serve::handle(std::make_shared<Serve::Connection>(STDIN_FILENO, STDOUT_FILENO, false), cache, pool);
+        pool.wait();
+        return static_cast<int>(ExitCodes::OK);
+    }
+
+    const auto path = args.get("socket", std::string());
+    const int listening = Serve::listenOn(path);
+    std::cerr << "serving on " << path << "\n";
+    while (true) {
+        int client = accept(listening, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("serve: accept() failed");
+        }
+        std::thread([client, &cache, &pool]() {
+            Serve::handle(std::make_shared<Serve::Connection>(client, client, true), cache, pool);
+        }).detach();
+    }
+}
+
+// solve, but answers come from the ResultCache when it has them, and go into it when it does not.
+// Parsing only happens if at least one part is not cached. --verify solves regardless, and checks the cache against the result.
+// Parts that do need solving run concurrently, unless --sequential.
+int solveCached(const Args& args, int day, Day& solver) {
+    const ResultCache cache(args.get("cache-dir", args[0] + "/.result_cache"));
+    const bool verify = args.has("verify");
+
+    std::array<std::optional<std::string>, 2> known { cache.get(day, 1, solver.inputText()), cache.get(day, 2, solver.inputText()) };
+    std::array<bool, 2> needed { ! known[0] || verify, ! known[1] || verify };
+    std::array<std::string, 2> computed;
+    if (needed[0] || needed[1]) {
+        solver.prepare();
+        if (needed[0] && needed[1] && ! args.has("sequential")) {
+            auto second = std::async(std::launch::async, [&solver]() { return solver.answer(2); });
+            computed[0] = solver.answer(1);
+            computed[1] = second.get();
+        } else {
+            for (int i = 0; i < 2; ++i) {
+                if (needed[i]) computed[i] = solver.answer(i + 1);
+            }
+        }
+    }
+
+    int mismatches = 0;
+    for (int i = 0; i < 2; ++i) {
+        if (! needed[i]) {
+            std::cout << "v" << (i + 1) << ": " << *known[i] << "\n";
+            continue;
+        }
+        if (known[i] && *known[i] != computed[i]) {
+            std::cout << "cache mismatch for part " << (i + 1) << ": cached " << *known[i] << "\n";
+            ++mismatches;
+        }
+        cache.put(day, i + 1, solver.inputText(), computed[i]);
+        std::cout << "v" << (i + 1) << ": " << computed[i] << "\n";
+    }
+    return static_cast<int>(mismatches > 0 ? ExitCodes::CACHE_MISMATCH : ExitCodes::OK);
+}
+
+// Writes a synthetic input for a day, 'scale' big (see Generate::unit for what it counts), to --out or stdout.
+// The same arguments always give the same input.
+int generate(const Args& args) {
+    const int day = std::stoi(args[2]);
+    const auto scale = static_cast<size_t>(std::stoull(args[3]));
+    const auto seed = static_cast<uint64_t>(std::stoull(args[4]));
+
+    if (Generate::unit(day) == nullptr) {
+        std::cerr << "day " << day << " has a fixed size input, the scale is ignored\n";
+    }
+    const std::string text = Generate::generate(day, scale, seed);
+
+    if (! args.has("out")) {
+        std::cout << text;
+        return static_cast<int>(ExitCodes::OK);
+    }
+    auto path = args.get("out", std::string());
+    std::ofstream out(path, std::ios::binary);
+    if (! (out << text)) throw std::invalid_argument("could not write: " + path);
     return static_cast<int>(ExitCodes::OK);
-}
\ No newline at end of file
+}
+
+// Benchmarks a day on generated inputs of growing size (see Generate), and fits how the time and peak memory of each phase grow
+// with it (see Scaling). Sizes run from --from to --to, --factor apart: by default from a 16th to 4 times the checked-in input,
+// doubling. Every size gets --budget seconds per phase (2 by default), but a single call always runs to the end.
+// Memory is the peak heap where allocations are counted (AOC_TRACK_ALLOCATIONS), and otherwise the phase's peak RSS,
+// which also holds the program and the generated input, so its fit comes out flatter at small n.
+int scaleCurves(const Args& args, int day) {
+    const char* unit = Generate::unit(day);
+    if (unit == nullptr) {
+        std::cout << "day " << day << " has a fixed size input, there is nothing to scale\n";
+        return static_cast<int>(ExitCodes::BAD_INPUT);
+    }
+    const int puzzle = static_cast<int>(Generate::puzzle(day));
+    const auto sizes = Scaling::geometric(args.get("from", std::max(1, puzzle / 16)), args.get("to", puzzle * 4), args.get("factor", 2.0));
+    const auto seed = static_cast<uint64_t>(args.get("seed", 1));
+
+    static const std::vector<std::string> phases { "parse", "v1", "v2" };
+    int onlyPhase = -1;
+    if (args.has("phase")) {
+        auto iter = std::ranges::find(phases, args.get("phase", std::string()));
+        if (iter == phases.end()) throw std::invalid_argument("no such phase: " + args.get("phase", std::string()));
+        onlyPhase = static_cast<int>(iter - phases.begin());
+    }
+
+    BenchConfig defaults;
+    defaults.budget = chrono::seconds{2};
+    defaults.targetRse = 0.02;
+    defaults.maxSamples = 1000;
+    defaults.allocations = Alloc::compiled();
+    BenchConfig config = benchConfigFrom(args, defaults);
+    config.reportEveryPct = 0.0;
+
+    std::cout << "n = " << unit << ", seed " << seed << ", median time per phase";
+    const std::string memoryOf = config.allocations ? "heap" : "rss";
+    std::cout << " and (peak " << (config.allocations ? "heap" : "RSS") << ")";
+    std::cout << "\n" << std::left << std::setw(12) << "n" << std::setw(12) << "bytes";
+    for (int i = 0; i < 3; ++i) {
+        if (onlyPhase < 0 || onlyPhase == i) std::cout << std::setw(28) << phases[i];
+    }
+    std::cout << "\n";
+
+    std::vector<Scaling::Point> points;
+    for (auto n : sizes) {
+        std::string text;
+        try {
+            text = Generate::generate(day, n, seed);
+        } catch (const std::invalid_argument& e) {
+            std::cout << "stopped at n = " << n << ": " << e.what() << "\n";
+            break;
+        }
+        const size_t bytes = text.size();
+
+        Day::StatTriplet stats;
+        DayMap::get(day, MappedFile::fromBytes(std::move(text)))->benchmark(stats, config, false, onlyPhase);
+
+        std::cout << std::setw(12) << n << std::setw(12) << bytes;
+        for (int i = 0; i < 3; ++i) {
+            auto& s = stats[i];
+            if (s.n_samples() == 0) continue;
+            // an RSS peak is only this phase's if it could be reset before it, see Memory.
+            const int64_t peak = config.allocations ? (s.has_allocations() ? s.peak_live_bytes() : -1)
+                : (s.has_memory() && s.memory().peak_is_phase ? static_cast<int64_t>(s.memory().peak_rss_kb) << 10 : -1);
+            points.push_back({ phases[i], n, bytes, static_cast<int>(s.n_samples()),
+                static_cast<double>(s.median().count()), static_cast<double>(s.nth_ile(0.05).count()), static_cast<double>(s.nth_ile(0.95).count()), peak, memoryOf });
+            std::cout << std::setw(28) << (s.format(s.median()) + (peak >= 0 ? " (" + std::to_string(peak >> 10) + " kB)" : ""));
+        }
+        std::cout << std::endl;
+    }
+
+    std::vector<Scaling::Curve> curves;
+    for (auto& phase : phases) {
+        std::vector<double> ns, times, peaks;
+        for (auto& p : points) {
+            if (p.phase != phase) continue;
+            ns.push_back(static_cast<double>(p.n));
+            times.push_back(p.median);
+            peaks.push_back(static_cast<double>(p.peakBytes));
+        }
+        if (ns.size() < 2) continue;
+
+        auto tail = [&](const std::vector<double>& y) { return Scaling::localExponent(ns[ns.size() - 2], y[y.size() - 2], ns.back(), y.back()); };
+        curves.push_back({ phase, "time", Scaling::powerLaw(ns, times), tail(times) });
+        if (std::ranges::any_of(peaks, [](double b) { return b > 0; })) {
+            curves.push_back({ phase, memoryOf, Scaling::powerLaw(ns, peaks), tail(peaks) });
+        }
+    }
+
+    std::cout << "\nfit over all sizes (95% interval), and the slope between the two largest:\n";
+    for (auto& c : curves) {
+        std::cout << "  " << std::setw(6) << c.phase << std::setw(8) << c.of;
+        if (! c.fit.valid()) {
+            std::cout << "not enough nonzero points\n";
+            continue;
+        }
+        std::cout << std::fixed << std::setprecision(2) << "n^" << c.fit.exponent << " +- " << c.fit.ci95 << "  (R^2 " << std::setprecision(3) << c.fit.r2 << ")"
+                  << std::setprecision(2) << "  largest: n^" << c.tail << std::defaultfloat << std::setprecision(6) << "\n";
+    }
+    std::cout << std::right;
+
+    if (args.has("json")) {
+        auto path = args.get("json", std::string());
+        std::ofstream f(path);
+        if (! f) throw std::invalid_argument("could not write: " + path);
+        Scaling::writeJson(f, day, unit, seed, points, curves);
+    }
+    if (args.has("csv")) {
+        auto path = args.get("csv", std::string());
+        std::ofstream f(path);
+        if (! f) throw std::invalid_argument("could not write: " + path);
+        Scaling::writeCsv(f, day, points);
+    }
+    return static_cast<int>(ExitCodes::OK);
+}
+
+// Solves every day on a thread pool: each day's parse is a task, which queues its two parts as tasks of their own once it is done.
+// Answers are printed in day order at the end, so the whole run takes about as long as the slowest single part.
+int solveEverything(const Args& args) {
+    const int jobs = std::max(1, args.get("jobs", static_cast<int>(std::thread::hardware_concurrency())));
+
+    struct Solved {
+        std::unique_ptr<Day> solver;
+        std::array<std::string, 2> answers;
+        std::string error; // the first failure of this day, if any.
+        std::mutex error_mutex;
+    };
+    std::vector<std::pair<int, Solved>> days(DayMap::NtoDay.size());
+
+    const auto start = chrono::steady_clock::now();
+    {
+        ThreadPool pool(jobs);
+        size_t i = 0;
+        for (auto& [day, factory] : DayMap::NtoDay) {
+            auto& [number, solved] = days[i++];
+            number = day;
+            pool.submit([&pool, &solved, day]() {
+                auto fail = [&solved](const std::exception& e) {
+                    std::lock_guard lock(solved.error_mutex);
+                    if (solved.error.empty()) solved.error = e.what();
+                };
+                try {
+                    solved.solver = DayMap::get(day);
+                    solved.solver->prepare();
+                } catch (const std::exception& e) {
+                    fail(e);
+                    return;
+                }
+                for (int part : { 1, 2 }) {
+                    pool.submit([&solved, fail, part]() {
+                        try {
+                            solved.answers[part - 1] = solved.solver->answer(part);
+                        } catch (const std::exception& e) {
+                            fail(e);
+                        }
+                    });
+                }
+            });
+        }
+        pool.wait();
+    }
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    int failures = 0;
+    for (auto& [day, solved] : days) {
+        if (! solved.error.empty()) {
+            std::cout << "Day " << day << " failed: " << solved.error << "\n";
+            ++failures;
+            continue;
+        }
+        std::cout << "Day " << day << " v1: " << solved.answers[0] << "\n";
+        std::cout << "Day " << day << " v2: " << solved.answers[1] << "\n";
+    }
+    std::cout << days.size() << " days in " << elapsed.count() << " s on " << jobs << " threads\n";
+    return static_cast<int>(failures > 0 ? ExitCodes::BAD_INPUT : ExitCodes::OK);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <set>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace Affinity {
+
+    // One logical CPU per physical core that this process is allowed to run on.
+    // Hyper-threading siblings share execution units, so benchmarking on both halves of a core would skew the numbers.
+    // Falls back to every allowed CPU if the topology is not readable (e.g. not Linux, or a locked down container).
+    inline std::vector<int> physicalCores() {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+            return { 0 };
+        }
+
+        std::vector<int> result;
+        std::set<std::pair<int, int>> seen_cores; // (package, core)
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (! CPU_ISSET(cpu, &allowed)) continue;
+
+            const std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+            std::ifstream core_file(topology + "core_id");
+            std::ifstream package_file(topology + "physical_package_id");
+            int core = cpu;
+            int package = 0;
+            if (core_file && package_file) {
+                core_file >> core;
+                package_file >> package;
+            }
+
+            if (seen_cores.emplace(package, core).second) {
+                result.push_back(cpu);
+            }
+        }
+
+        if (result.empty()) result.push_back(0);
+        return result;
+    }
+
+    // Pins the calling thread to a single CPU. Returns false if the OS refused, which is not fatal: the work still runs, just unpinned.
+    inline bool pinCurrentThread(int cpu) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+}
@@ -0,0 +1,101 @@
+#include "Alloc.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#include <malloc.h>
+
+namespace {
+    thread_local bool tracking = false;
+    thread_local Alloc::Counters counters;
+}
+
+namespace Alloc {
+    bool compiled() {
+#ifdef AOC_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void track(bool on) { tracking = on; }
+
+    Counters snapshot() { return counters; }
+
+    void resetPeak() { counters.peak = counters.live; }
+}
+
+#ifdef AOC_TRACK_ALLOCATIONS
+
+// Every replaceable form of operator new and delete, on top of malloc / aligned_alloc and free.
+// Anything not replaced here would still go to the default implementation, and mixing the two corrupts the heap.
+
+namespace {
+    void allocated(void* p) {
+        if (! tracking || ! p) return;
+        auto size = static_cast<int64_t>(malloc_usable_size(p));
+        ++counters.allocations;
+        counters.bytes += size;
+        counters.live += size;
+        if (counters.live > counters.peak) counters.peak = counters.live;
+    }
+
+    void freed(void* p) {
+        if (! tracking || ! p) return;
+        counters.live -= static_cast<int64_t>(malloc_usable_size(p));
+    }
+
+    void* allocate(std::size_t n) {
+        void* p = std::malloc(n ? n : 1);
+        if (! p) throw std::bad_alloc();
+        allocated(p);
+        return p;
+    }
+
+    void* allocate(std::size_t n, std::align_val_t a) {
+        auto align = static_cast<std::size_t>(a);
+        void* p = std::aligned_alloc(align, ((n ? n : 1) + align - 1) / align * align); // size must be a multiple of the alignment.
+        if (! p) throw std::bad_alloc();
+        allocated(p);
+        return p;
+    }
+
+    void deallocate(void* p) noexcept {
+        freed(p);
+        std::free(p);
+    }
+}
+
+void* operator new(std::size_t n) { return allocate(n); }
+void* operator new[](std::size_t n) { return allocate(n); }
+void* operator new(std::size_t n, std::align_val_t a) { return allocate(n, a); }
+void* operator new[](std::size_t n, std::align_val_t a) { return allocate(n, a); }
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    try { return allocate(n); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    try { return allocate(n); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    try { return allocate(n, a); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    try { return allocate(n, a); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { deallocate(p); }
+void operator delete[](void* p) noexcept { deallocate(p); }
+void operator delete(void* p, std::size_t) noexcept { deallocate(p); }
+void operator delete[](void* p, std::size_t) noexcept { deallocate(p); }
+void operator delete(void* p, std::align_val_t) noexcept { deallocate(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { deallocate(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { deallocate(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { deallocate(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { deallocate(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { deallocate(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(p); }
+
+#endif
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Counts heap allocations made through operator new, per thread. The replacement operators live in Alloc.cpp,
+ * and are only compiled in when CMake's AOC_TRACK_ALLOCATIONS is on (compiled() says whether they were).
+ *
+ * Even then nothing is counted until a thread calls track(true): an untracked new costs one thread-local branch.
+ * Bytes are what the allocator actually handed out (malloc_usable_size), so frees can be subtracted exactly.
+ * 'live' can go negative on a thread that frees memory another thread allocated; only differences are meaningful.
+ */
+namespace Alloc {
+
+    struct Counters {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0; // total handed out, frees not subtracted.
+        int64_t live = 0; // currently allocated by this thread.
+        int64_t peak = 0; // highest 'live' since the last resetPeak().
+    };
+
+    bool compiled();
+
+    void track(bool on);
+
+    // this thread's counters.
+    Counters snapshot();
+
+    // sets the peak to the current live bytes, so the next snapshot's peak is the high-water mark since now.
+    void resetPeak();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * A monotonic arena: allocating bumps a pointer, deallocating does nothing, and rewind() hands all of it out again at once.
+ *
+ * For the short-lived containers of one solve (a BFS queue, a seen set). Day::bench rewinds it between calls, so after the
+ * first call, which grows it to what a solve needs, a solve no longer touches malloc at all. Unlike
+ * std::pmr::monotonic_buffer_resource, rewinding keeps the chunks, and is O(1).
+ *
+ * Not thread safe, one arena per thread.
+ */
+class Arena final : public std::pmr::memory_resource {
+public:
+    explicit Arena(size_t firstChunk = 64 << 10, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : firstChunk(firstChunk), upstream(upstream) {}
+
+    ~Arena() override {
+        for (auto& c : chunks) upstream->deallocate(c.data, c.size, alignof(std::max_align_t));
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // everything allocated so far is free again. The memory itself is kept, for the next round.
+    void rewind() {
+        current = 0;
+        used = 0;
+    }
+
+    // what the arena holds on to, in use or not.
+    [[nodiscard]] size_t capacity() const {
+        size_t total = 0;
+        for (auto& c : chunks) total += c.size;
+        return total;
+    }
+
+private:
+    struct Chunk {
+        std::byte* data;
+        size_t size;
+    };
+
+    size_t firstChunk;
+    std::pmr::memory_resource* upstream;
+    std::vector<Chunk> chunks;
+    size_t current = 0; // chunk being bumped through.
+    size_t used = 0; // of chunks[current].
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        while (true) {
+            if (current < chunks.size()) {
+                auto& c = chunks[current];
+                const auto base = reinterpret_cast<uintptr_t>(c.data);
+                const size_t start = ((base + used + alignment - 1) & ~(alignment - 1)) - base;
+                if (start + bytes <= c.size) {
+                    used = start + bytes;
+                    return c.data + start;
+                }
+                // a chunk too small for this request is skipped, the rest of it stays unused until the next rewind.
+                ++current;
+                used = 0;
+                continue;
+            }
+            // each chunk twice the last, so a solve that needs n bytes takes O(log n) chunks.
+            size_t size = chunks.empty() ? firstChunk : chunks.back().size * 2;
+            while (size < bytes + alignment) size *= 2;
+            chunks.push_back({ static_cast<std::byte*>(upstream->allocate(size, alignof(std::max_align_t))), size });
+            current = chunks.size() - 1;
+            used = 0;
+        }
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
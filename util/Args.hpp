@@ -0,0 +1,70 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+/**
+ * Splits argv into positional arguments and '--flag [value]' options.
+ *
+ * A flag takes the next argument as its value, unless that argument is itself a flag (or there is none),
+ * in which case the flag has an empty value. The known 'switches' never take a value, so "--cold 1000" leaves
+ * the 1000 positional. '--flag=value' always binds the value. Positional arguments keep their relative order,
+ * so the old "root mode day (sample_size)" calling convention still works with flags mixed in anywhere.
+ */
+class Args {
+public:
+    Args(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            std::string a = argv[i];
+            if (a.starts_with("--")) {
+                std::string name = a.substr(2);
+                std::string value;
+                if (auto equals = name.find('='); equals != std::string::npos) {
+                    value = name.substr(equals + 1);
+                    name.resize(equals);
+                } else if (! switches.contains(name) && i + 1 < argc && ! std::string(argv[i + 1]).starts_with("--")) {
+                    value = argv[++i];
+                }
+                flags[name] = value;
+            } else {
+                positional.emplace_back(std::move(a));
+            }
+        }
+    }
+
+    [[nodiscard]] size_t size() const { return positional.size(); }
+
+    [[nodiscard]] const std::string& operator[](size_t i) const { return positional.at(i); }
+
+    [[nodiscard]] bool has(const std::string& flag) const { return flags.contains(flag); }
+
+    [[nodiscard]] std::string get(const std::string& flag, const std::string& fallback) const {
+        auto iter = flags.find(flag);
+        return (iter == flags.end() || iter->second.empty()) ? fallback : iter->second;
+    }
+
+    [[nodiscard]] int get(const std::string& flag, int fallback) const {
+        auto iter = flags.find(flag);
+        if (iter == flags.end() || iter->second.empty()) return fallback;
+        return std::stoi(iter->second);
+    }
+
+    [[nodiscard]] double get(const std::string& flag, double fallback) const {
+        auto iter = flags.find(flag);
+        if (iter == flags.end() || iter->second.empty()) return fallback;
+        return std::stod(iter->second);
+    }
+
+private:
+    // flags that are on or off, and never take the next argument as a value.
+    static inline const std::set<std::string> switches {
+        "allocs", "cold", "cold-branches", "cold-tlb", "counters", "fork", "isolate-phases", "no-cache",
+        "sequential", "snapshot", "streaming", "thread-sweep", "verify",
+    };
+
+    std::vector<std::string> positional;
+    std::map<std::string, std::string> flags;
+};
@@ -8,6 +8,16 @@
 #include <stdexcept>
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <optional>
+
+#include "PerfCounters.hpp"
+#include "Alloc.hpp"
+#include "Memory.hpp"
+#include "Histogram.hpp"
+#include "Bootstrap.hpp"
+#include "Result.hpp"
 // todo: cannot #include format, need g++ 13 or higher. currently on 11.
 
 using Time = std::chrono::steady_clock::duration;
@@ -23,67 +33,277 @@ using Time = std::chrono::steady_clock::duration;
  * To get readable strings in other units, set 'unit' to the desired unit (e.g. std::chrono::milliseconds{1}), and call format().
  * To get a casted duration value yourself, divide the result by std::chrono::your_unit{1}.
  *
- * Maintains data temporally as well as ordinally.
+ * How samples are kept is chosen at construction (see Storage):
+ * ALL_SAMPLES maintains data temporally as well as ordinally.
  * The ordinal data is generated on-demand. That is, there is no sort unless asked for.
  * Data is sorted only once, unless more is added after a demand for sorting through measurement().
+ * STREAMING keeps no samples at all, only running moments and a LogHistogram, so memory stays fixed for any sample count.
+ * Its percentiles are then accurate to within a bucket (< 1%) instead of exact.
+ * Mean, standard deviation, lowest and highest are exact in both.
  */
 class BenchmarkStats {
 public:
+    enum class Storage {
+        ALL_SAMPLES,
+        STREAMING,
+    };
+
     BenchmarkStats() : unit(1) { }
-    explicit BenchmarkStats(const Time& representation_unit) : unit(representation_unit) { }
+    explicit BenchmarkStats(const Time& representation_unit, Storage how = Storage::ALL_SAMPLES) : unit(representation_unit), storage(how) {
+        if (storage == Storage::STREAMING) histogram.emplace();
+    }
+
+    // Why the sampler stopped taking measurements. Set by whoever drives the sampling, reported in operator<<.
+    enum class StopReason {
+        SAMPLE_COUNT, // took every sample that was asked for.
+        BUDGET, // ran out of wall-clock time.
+        CONVERGED, // relative standard error of the mean dropped below the target.
+    };
 
     void measurement(Time t) {
-        all.push_back(t);
+        if (histogram) {
+            histogram->record(static_cast<uint64_t>(std::max(Time{0}, t).count()));
+        } else {
+            all.push_back(t);
+        }
+        ++count;
+        minimum = std::min(minimum, t);
+        maximum = std::max(maximum, t);
+
+        // Welford's online update, so the sampler can ask for the standard error after every sample without an O(n) pass.
+        // Also the only way std_dev is computed: a Time::rep sum of squares overflows after a handful of 1-second samples.
+        auto x = static_cast<double>(t.count());
+        double delta = x - running_mean;
+        running_mean += delta / static_cast<double>(count);
+        running_m2 += delta * (x - running_mean);
+    }
+
+    void stopped(StopReason why, int warmup_iterations) {
+        stop_reason = why;
+        warmups = warmup_iterations;
+    }
+
+    // every measurement is the average of this many back to back calls. See Day::bench.
+    void batched(int calls) { calls_per_sample = calls; }
+    [[nodiscard]] int n_calls_per_sample() const { return calls_per_sample; }
+
+    // event counts over one sample of 'calls' calls, scaled for multiplexing. Only what the counters could actually measure
+    // ('available') is reported, and an event that was not scheduled at all during a sample leaves that sample out.
+    void counters(const PerfCounters::Delta& delta, int calls, const PerfCounters& available) {
+        bool missed = false;
+        for (int e = 0; e < PerfCounters::N_EVENTS; ++e) {
+            if (! available.has(static_cast<PerfCounters::Event>(e))) continue;
+            if (! delta.measured[e]) {
+                missed = true;
+                continue;
+            }
+            counter_totals[e] += delta.count[e];
+            counted_calls[e] += calls;
+        }
+        unscheduled_samples += missed;
+    }
+
+    // heap activity over one sample of 'calls' calls: 'delta' between two Alloc snapshots, 'peak' the high-water mark above the live bytes at the start.
+    void allocations(const Alloc::Counters& delta, int64_t peak, int calls) {
+        alloc_totals.allocations += delta.allocations;
+        alloc_totals.bytes += delta.bytes;
+        alloc_totals.peak = std::max(alloc_totals.peak, peak);
+        alloc_calls += calls;
+    }
+
+    [[nodiscard]] bool has_allocations() const { return alloc_calls > 0; }
+    [[nodiscard]] double allocations_per_call() const { return static_cast<double>(alloc_totals.allocations) / static_cast<double>(alloc_calls); }
+    [[nodiscard]] double bytes_per_call() const { return static_cast<double>(alloc_totals.bytes) / static_cast<double>(alloc_calls); }
+    // over a whole sample, so for batched samples this is the peak of 'n_calls_per_sample()' calls in a row.
+    [[nodiscard]] int64_t peak_live_bytes() const { return alloc_totals.peak; }
+
+    // resident memory and page faults over the whole phase, warmup included. See Day::bench.
+    void memory(const Memory::Usage& usage) { mem = usage; }
+    [[nodiscard]] const Memory::Usage& memory() const { return mem; }
+    [[nodiscard]] bool has_memory() const { return mem.peak_rss_kb > 0; }
+
+    // a sample's answer, checked against the known one (BenchConfig::expected). The first wrong answer is kept, to show.
+    void verified(const Result& answer, bool correct) {
+        ++answers_checked;
+        if (! correct && answers_wrong++ == 0) first_wrong = answer.str();
+    }
+
+    [[nodiscard]] bool has_verification() const { return answers_checked > 0; }
+    [[nodiscard]] uint64_t answers_verified() const { return answers_checked; }
+    [[nodiscard]] uint64_t wrong_answers() const { return answers_wrong; }
+    [[nodiscard]] const std::string& first_wrong_answer() const { return first_wrong; }
+
+    [[nodiscard]] bool has_counter(PerfCounters::Event e) const { return counted_calls[e] > 0; }
+
+    // assumes has_counter(e).
+    [[nodiscard]] double per_call(PerfCounters::Event e) const {
+        return static_cast<double>(counter_totals[e]) / static_cast<double>(counted_calls[e]);
+    }
+
+    // samples in which at least one available event was never scheduled, and so has no count.
+    [[nodiscard]] uint64_t counter_gaps() const { return unscheduled_samples; }
+
+    [[nodiscard]] StopReason stopped_because() const { return stop_reason; }
+    [[nodiscard]] std::string stop_description() const { return describe(stop_reason); }
+
+    // also what Report writes, and reads back.
+    static std::string describe(StopReason why) {
+        switch (why) {
+            case StopReason::SAMPLE_COUNT: return "sample count";
+            case StopReason::BUDGET: return "time budget";
+            case StopReason::CONVERGED: return "converged";
+        }
+        return "?";
+    }
+
+    [[nodiscard]] int n_warmups() const { return warmups; }
+
+    // standard error of the mean divided by the mean. Infinite until there are at least 2 samples.
+    [[nodiscard]] double relative_std_error() const {
+        if (count < 2 || running_mean <= 0) return std::numeric_limits<double>::infinity();
+
+        auto n = static_cast<double>(count);
+        double variance = running_m2 / (n - 1);
+        return std::sqrt(variance / n) / running_mean;
     }
 
     [[nodiscard]] size_t n_samples () const {
-        return all.size();
+        return count;
     }
 
+    [[nodiscard]] Storage storage_kind() const { return storage; }
+
+    // every sample, earliest first. Empty when STREAMING.
+    [[nodiscard]] const std::vector<Time>& samples() const { return all; }
+
     void reset () {
         all.clear();
         sorted.clear();
+        if (histogram) histogram->clear();
+        count = 0;
+        minimum = Time::max();
+        maximum = Time::min();
+        running_mean = 0;
+        running_m2 = 0;
+        stop_reason = StopReason::SAMPLE_COUNT;
+        warmups = 0;
+        calls_per_sample = 1;
+        counter_totals.fill(0);
+        counted_calls.fill(0);
+        unscheduled_samples = 0;
+        alloc_totals = {};
+        alloc_calls = 0;
+        mem = {};
+        answers_checked = 0;
+        answers_wrong = 0;
+        first_wrong.clear();
     }
 
-    void reserve(int n) { all.reserve(n); }
+    void reserve(int n) {
+        if (storage == Storage::ALL_SAMPLES) all.reserve(n);
+    }
 
     [[nodiscard]] Time lowest() const {
-        return * std::min_element(all.begin(), all.end());
+        return minimum;
     }
 
     [[nodiscard]] Time highest() const {
-        return * std::max_element(all.begin(), all.end());
+        return maximum;
     }
 
     // assumes size > 0
     [[nodiscard]] Time mean() const {
+        if (storage == Storage::STREAMING) {
+            return Time { static_cast<Time::rep>(std::llround(running_mean)) };
+        }
         auto sum = std::accumulate(all.begin(), all.end(), Time{});
         return sum / all.size();
     }
 
     // assumes size > 0
     [[nodiscard]] Time median() const {
-        if (all.size() % 2 == 1) {
-            return all[all.size() / 2];
+        if (storage == Storage::STREAMING) {
+            return nth_ile(0.5);
+        }
+
+        auto& s = get_sorted();
+        if (s.size() % 2 == 1) {
+            return s[s.size() / 2];
         } else {
-            return (all[n_samples() / 2] + all[n_samples() / 2 - 1]) / 2;
+            return (s[s.size() / 2] + s[s.size() / 2 - 1]) / 2;
         }
     }
 
     [[nodiscard]] Time std_dev() const {
-        if (all.size() <= 1) { return Time{0}; } // 0 divided by 0 otherwise, it's a bad time.
+        if (count <= 1) { return Time{0}; } // 0 divided by 0 otherwise, it's a bad time.
+
+        auto result = std::sqrt(running_m2 / static_cast<double>(count - 1));
+        return Time { static_cast<Time::rep>(result) };
+    }
+
+    // Bootstrapping and outlier counts need every sample, and at least two of them.
+    [[nodiscard]] bool has_samples_for_analysis() const {
+        return storage == Storage::ALL_SAMPLES && count >= 2;
+    }
+
+    // BCa bootstrap confidence intervals. Assume has_samples_for_analysis().
+    [[nodiscard]] std::pair<Time, Time> mean_ci(double confidence = 0.95) const {
+        return to_times(Bootstrap::mean(as_doubles(all), confidence));
+    }
+
+    [[nodiscard]] std::pair<Time, Time> median_ci(double confidence = 0.95) const {
+        return to_times(Bootstrap::median(as_doubles(get_sorted()), confidence));
+    }
+
+    // Tukey's fences: 'mild' is beyond 1.5 interquartile ranges from the nearest quartile, 'severe' beyond 3.
+    // Severe ones are counted only as severe, not also as mild.
+    struct Outliers {
+        size_t low_severe = 0;
+        size_t low_mild = 0;
+        size_t high_mild = 0;
+        size_t high_severe = 0;
+    };
 
-        auto x = mean();
-        Time::rep squaredSum = 0;
-        for (auto& s : all) {
-            squaredSum += (s - x).count() * (s - x).count();
+    // assumes has_samples_for_analysis().
+    [[nodiscard]] Outliers outliers() const {
+        auto q1 = nth_ile(0.25);
+        auto q3 = nth_ile(0.75);
+        auto iqr = q3 - q1;
+        Outliers o;
+        for (auto& t : get_sorted()) {
+            if (t < q1 - 3 * iqr) ++o.low_severe;
+            else if (t < q1 - iqr * 3 / 2) ++o.low_mild;
+            else if (t > q3 + 3 * iqr) ++o.high_severe;
+            else if (t > q3 + iqr * 3 / 2) ++o.high_mild;
         }
-        auto result = std::sqrt(squaredSum / (n_samples() - 1));
-        return Time {static_cast<decltype(squaredSum)>(result) };
+        return o;
+    }
+
+    // How small a change between two runs of this phase could be told apart from noise, judged by the width of the median's CI:
+    // two runs whose intervals do not overlap differ by at least about the full width.
+    // 'medianCi' and 'o' are median_ci() and outliers(), which the caller has usually computed already. The bootstrap is not cheap.
+    // assumes has_samples_for_analysis().
+    [[nodiscard]] std::string noise_verdict(const std::pair<Time, Time>& medianCi, const Outliers& o) const {
+        auto [lo, hi] = medianCi;
+        auto m = static_cast<double>(median().count());
+        if (m <= 0) return "unknown (median is 0)";
+
+        double resolution = static_cast<double>((hi - lo).count()) / m;
+        double severe = static_cast<double>(o.low_severe + o.high_severe) / static_cast<double>(count);
+
+        std::string verdict;
+        if (resolution <= 0.01 && severe <= 0.01) verdict = "quiet";
+        else if (resolution <= 0.03 && severe <= 0.05) verdict = "some noise";
+        else verdict = "noisy";
+
+        return verdict + ", resolves changes above ~" + std::to_string(resolution * 100).substr(0, 4) + "%";
     }
 
     // assumes 0 < ile < 1
     [[nodiscard]] Time nth_ile(double ile) const {
+        if (storage == Storage::STREAMING) {
+            return Time { static_cast<Time::rep>(histogram->quantile(ile)) };
+        }
         return get_sorted()[static_cast<int>(n_samples() * ile)]; // NOLINT(cppcoreguidelines-narrowing-conversions) -- if you have 2^53 measurements you have bigger problems.
     }
 
@@ -91,8 +311,37 @@ private:
     friend std::ostream& operator<<(std::ostream& o, const BenchmarkStats& b);
 
     Time unit; // controls unit printed in operator<<. Change by assigning e.g. std::chrono::milliseconds{1}.
-    std::vector<Time> all; // aligned 'temporally', i.e. earliest first, appended by measure();
+    Storage storage = Storage::ALL_SAMPLES;
+    std::vector<Time> all; // aligned 'temporally', i.e. earliest first, appended by measure(). Empty when STREAMING.
     std::vector<Time> sorted; // only created if required by function calls. Transparently maintained. Do not use other than through get_sorted().
+    std::optional<LogHistogram> histogram; // only when STREAMING.
+    size_t count = 0;
+    Time minimum = Time::max();
+    Time maximum = Time::min();
+    double running_mean = 0; // in Time::rep, maintained by measurement().
+    double running_m2 = 0; // sum of squared differences from the running mean, in Time::rep squared.
+    StopReason stop_reason = StopReason::SAMPLE_COUNT;
+    int warmups = 0;
+    int calls_per_sample = 1;
+    std::array<uint64_t, PerfCounters::N_EVENTS> counter_totals {}; // summed over every sample the event was scheduled in.
+    std::array<uint64_t, PerfCounters::N_EVENTS> counted_calls {}; // the calls in those samples.
+    uint64_t unscheduled_samples = 0;
+    Alloc::Counters alloc_totals {}; // allocations and bytes summed, peak the largest of any sample. 'live' unused.
+    uint64_t alloc_calls = 0;
+    Memory::Usage mem {};
+    uint64_t answers_checked = 0;
+    uint64_t answers_wrong = 0;
+    std::string first_wrong;
+
+    static std::vector<double> as_doubles(const std::vector<Time>& times) {
+        std::vector<double> result(times.size());
+        std::ranges::transform(times, result.begin(), [](const Time& t) { return static_cast<double>(t.count()); });
+        return result;
+    }
+
+    static std::pair<Time, Time> to_times(const Bootstrap::Interval& i) {
+        return { Time { static_cast<Time::rep>(std::llround(i.low)) }, Time { static_cast<Time::rep>(std::llround(i.high)) } };
+    }
 
     [[nodiscard]] const std::vector<Time>& get_sorted() const {
         /** Bad To the Bone Riff */
@@ -106,8 +355,8 @@ private:
         return sorted;
     }
 
-    friend int benchEverything();
-    // absolute mess of code, it keeps breaking I hate this.
+public:
+    // 'value' in a unit that suits it, starting from 'unit'. Absolute mess of code, it keeps breaking I hate this.
     [[nodiscard]] std::string format(const Time& value) const {
         if (value.count() == 0) { // 0 will result in infinite loops when upgrading/downgrading displayed time unit. Might as well exit early and just say it's zero.
             return "0 ns";
@@ -160,13 +409,63 @@ private:
 inline std::ostream& operator<<(std::ostream& o, const BenchmarkStats& b) {
     o
     << "BenchStats {" << "\n"
-    << "\tSample Size: " << b.n_samples() << "\n"
+    << "\tSample Size: " << b.n_samples();
+    if (b.n_calls_per_sample() > 1) o << " x " << b.n_calls_per_sample() << " calls";
+    o
+    << " (stopped on " << b.stop_description() << ", " << b.n_warmups() << " warmup)\n"
     << "\tMean (Median): " << b.format(b.mean()) << " (" << b.format(b.median()) << ")\n"
     << "\tStdDev: " << b.format(b.std_dev()) << "\n"
     << "\tlowest / highest: " << b.format(b.lowest()) << " / " << b.format(b.highest()) << "\n"
-    << "\t5/95 %-ile: " << b.format(b.nth_ile(0.05)) << " / " << b.format(b.nth_ile(0.95)) << "\n" // might have mixed up the definition of %-ile, maybe the labels should be swapped. oh well.
-    //<< "\tCI (95% 2-sided)" << "\n" // excessive.
-    << "}";
+    << "\t5/95 %-ile: " << b.format(b.nth_ile(0.05)) << " / " << b.format(b.nth_ile(0.95)) << "\n" // 5% of samples are faster than the first, 5% slower than the second. The labels were right after all.
+    << "\tp50 / p90 / p99 / p99.9: " << b.format(b.nth_ile(0.5)) << " / " << b.format(b.nth_ile(0.9)) << " / " << b.format(b.nth_ile(0.99)) << " / " << b.format(b.nth_ile(0.999)) << "\n"
+    ;
+
+    if (b.has_samples_for_analysis()) {
+        auto [mean_lo, mean_hi] = b.mean_ci();
+        auto median_ci = b.median_ci();
+        auto [median_lo, median_hi] = median_ci;
+        auto out = b.outliers();
+        o
+        << "\tMean CI (95% BCa): " << b.format(mean_lo) << " - " << b.format(mean_hi) << "\n"
+        << "\tMedian CI (95% BCa): " << b.format(median_lo) << " - " << b.format(median_hi) << "\n"
+        << "\tOutliers (mild / severe): low " << out.low_mild << " / " << out.low_severe << ", high " << out.high_mild << " / " << out.high_severe << "\n"
+        << "\tNoise: " << b.noise_verdict(median_ci, out) << "\n";
+    }
+
+    using E = PerfCounters::Event;
+    if (b.has_counter(E::CYCLES) && b.has_counter(E::INSTRUCTIONS) && b.per_call(E::CYCLES) > 0) {
+        o << "\tIPC: " << b.per_call(E::INSTRUCTIONS) / b.per_call(E::CYCLES) << " (" << b.per_call(E::INSTRUCTIONS) << " instructions / call)\n";
+    }
+    bool any = false;
+    for (auto e : { E::CYCLES, E::BRANCH_MISSES, E::L1D_MISSES, E::LLC_MISSES, E::PAGE_FAULTS }) {
+        if (! b.has_counter(e)) continue;
+        o << (any ? ", " : "\tper call: ") << b.per_call(e) << " " << PerfCounters::name(e);
+        any = true;
+    }
+    if (any) o << "\n";
+    if (b.counter_gaps() > 0) {
+        o << "\tCounters: some events were not scheduled in " << b.counter_gaps() << " samples, those samples are left out of their per call numbers\n";
+    }
+
+    if (b.has_memory()) {
+        auto& m = b.memory();
+        o << "\tMemory: peak RSS " << (std::round(static_cast<double>(m.peak_rss_kb) / 102.4) / 10) << " MB (" << (m.peak_is_phase ? "this phase" : "process") << ")"
+          << ", page faults " << m.faults.minor << " minor / " << m.faults.major << " major\n";
+    }
+
+    if (b.has_allocations()) {
+        o << "\tHeap per call: " << b.allocations_per_call() << " allocations, " << b.bytes_per_call() << " bytes (peak live " << b.peak_live_bytes() << " bytes)\n";
+    }
+
+    if (b.has_verification()) {
+        if (b.wrong_answers() == 0) {
+            o << "\tAnswers: all " << b.answers_verified() << " samples correct\n";
+        } else {
+            o << "\tWRONG ANSWER in " << b.wrong_answers() << " of " << b.answers_verified() << " samples, e.g. " << b.first_wrong_answer() << "\n";
+        }
+    }
+
+    o << "}";
 
     return o;
 }
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <cmath>
+#include <utility>
+
+/**
+ * Bias-corrected and accelerated (BCa) bootstrap confidence intervals, for the mean and the median of a set of samples.
+ *
+ * Benchmark timings are skewed (a hard floor, a long tail of interruptions), so the plain percentile bootstrap is biased.
+ * BCa corrects for that with z0 (how far the bootstrap distribution sits off the real estimate) and the acceleration
+ * (how fast the spread changes with the value, from the jackknife). See Efron & Tibshirani, An Introduction to the Bootstrap, ch. 14.
+ *
+ * Resampling uses a fixed seed, so printing the same stats twice gives the same interval.
+ */
+namespace Bootstrap {
+
+    struct Interval {
+        double low;
+        double high;
+    };
+
+    inline double normal_cdf(double z) {
+        return 0.5 * std::erfc(-z / std::sqrt(2.0));
+    }
+
+    // inverse of normal_cdf by bisection. Not fast, but it is called four times per interval.
+    inline double normal_quantile(double p) {
+        double lo = -10, hi = 10;
+        for (int i = 0; i < 100; ++i) {
+            double mid = (lo + hi) / 2;
+            if (normal_cdf(mid) < p) lo = mid; else hi = mid;
+        }
+        return (lo + hi) / 2;
+    }
+
+    // 'replicates': the statistic on each bootstrap resample. 'jackknife': the statistic with each sample left out once.
+    inline Interval bca(double estimate, std::vector<double> replicates, const std::vector<double>& jackknife, double confidence) {
+        std::sort(replicates.begin(), replicates.end());
+        const auto b = static_cast<double>(replicates.size());
+
+        // ties count half, otherwise a statistic that often resamples to exactly the estimate (the median, on integer nanoseconds) looks biased.
+        auto below = std::lower_bound(replicates.begin(), replicates.end(), estimate) - replicates.begin();
+        auto equal = std::upper_bound(replicates.begin(), replicates.end(), estimate) - replicates.begin() - below;
+        double proportion = (static_cast<double>(below) + 0.5 * static_cast<double>(equal)) / b;
+        proportion = std::clamp(proportion, 1.0 / b, 1.0 - 1.0 / b);
+        const double z0 = normal_quantile(proportion);
+
+        const double jack_mean = std::accumulate(jackknife.begin(), jackknife.end(), 0.0) / static_cast<double>(jackknife.size());
+        double num = 0, den = 0;
+        for (double j : jackknife) {
+            double d = jack_mean - j;
+            num += d * d * d;
+            den += d * d;
+        }
+        const double a = den > 0 ? num / (6 * std::pow(den, 1.5)) : 0.0;
+
+        auto adjusted = [&](double alpha) {
+            double z = normal_quantile(alpha);
+            double p = normal_cdf(z0 + (z0 + z) / (1 - a * (z0 + z)));
+            auto i = static_cast<size_t>(std::clamp(p * b, 0.0, b - 1));
+            return replicates[i];
+        };
+
+        const double tail = (1 - confidence) / 2;
+        return { adjusted(tail), adjusted(1 - tail) };
+    }
+
+    inline double median_of_sorted(const std::vector<double>& s) {
+        auto n = s.size();
+        return n % 2 == 1 ? s[n / 2] : (s[n / 2 - 1] + s[n / 2]) / 2;
+    }
+
+    inline Interval mean(const std::vector<double>& samples, double confidence = 0.95, int resamples = 2000) {
+        const auto n = samples.size();
+        const double sum = std::accumulate(samples.begin(), samples.end(), 0.0);
+
+        std::mt19937_64 rng(0x5eed);
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        std::vector<double> replicates(resamples);
+        for (auto& r : replicates) {
+            double s = 0;
+            for (size_t i = 0; i < n; ++i) s += samples[pick(rng)];
+            r = s / static_cast<double>(n);
+        }
+
+        std::vector<double> jackknife(n);
+        for (size_t i = 0; i < n; ++i) {
+            jackknife[i] = (sum - samples[i]) / static_cast<double>(n - 1);
+        }
+
+        return bca(sum / static_cast<double>(n), std::move(replicates), jackknife, confidence);
+    }
+
+    // 'sorted' must be in ascending order.
+    inline Interval median(const std::vector<double>& sorted, double confidence = 0.95, int resamples = 2000) {
+        const auto n = sorted.size();
+
+        std::mt19937_64 rng(0x5eed);
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        std::vector<double> replicates(resamples);
+        std::vector<double> resample(n);
+        for (auto& r : replicates) {
+            for (auto& x : resample) x = sorted[pick(rng)];
+            auto mid = resample.begin() + static_cast<long>(n / 2);
+            std::nth_element(resample.begin(), mid, resample.end());
+            r = *mid;
+            if (n % 2 == 0) r = (r + *std::max_element(resample.begin(), mid)) / 2;
+        }
+
+        // leaving out sample i of a sorted set only ever moves the median to one of two or three neighbours, so this is O(n), not O(n^2).
+        std::vector<double> jackknife(n);
+        const size_t m = n - 1; // size after leaving one out.
+        for (size_t i = 0; i < n; ++i) {
+            auto at = [&](size_t k) { return k < i ? sorted[k] : sorted[k + 1]; }; // k-th element without i.
+            jackknife[i] = m % 2 == 1 ? at(m / 2) : (at(m / 2 - 1) + at(m / 2)) / 2;
+        }
+
+        return bca(median_of_sorted(sorted), std::move(replicates), jackknife, confidence);
+    }
+}
@@ -9,12 +9,54 @@
 #include <functional>
 #include <any>
 #include <filesystem>
+#include <optional>
+#include <atomic>
+#include <future>
+#include <array>
+#include <typeinfo>
 
 #include "BenchStats.hpp"
+#include "Input.hpp"
+#include "Log.hpp"
+#include "Evict.hpp"
+#include "Trace.hpp"
+#include "Result.hpp"
+#include "Arena.hpp"
+#include "Snapshot.hpp"
 
 namespace chrono = std::chrono;
 
-using PrinterCallback = std::function<void(const char *)>;
+/**
+ * Knobs for how long Day::bench keeps sampling a phase.
+ *
+ * Sampling stops at whichever comes first: 'maxSamples' measurements, 'budget' of wall-clock time spent on the phase
+ * (warmup included), or the relative standard error of the mean dropping below 'targetRse'.
+ * The defaults reproduce the old behaviour: a fixed 10k samples, no warmup.
+ */
+struct BenchConfig {
+    int maxSamples = 10'000;
+    int warmup = 0; // iterations run before measuring, to fill caches and let the branch predictors learn. Discarded.
+    chrono::duration<double> budget = chrono::duration<double>::max(); // per phase.
+    double targetRse = 0.0; // 0 disables the convergence rule.
+    int minSamples = 10; // the convergence rule is not trusted with fewer samples than this, a handful of lucky samples can look very stable.
+    double reportEveryPct = 0.05; // non-positive means silent, e.g. when several days are benched concurrently.
+    // Phases faster than this are called several times back to back per sample, so the timer is not measuring mostly itself.
+    // 0 disables batching, every sample is then exactly one call.
+    chrono::nanoseconds batchTarget = chrono::microseconds{1};
+    bool counters = false; // also record hardware counters per sample, if the kernel lets us.
+    bool allocations = false; // also count heap allocations per sample. Needs the AOC_TRACK_ALLOCATIONS build option.
+    bool streaming = false; // fixed-memory stats: no samples kept, percentiles from a histogram. For million-sample runs.
+    // evict the caches before every sample (CacheEvictor), so each call runs cold. Implies no batching.
+    // Cold phases count the eviction buffer in their peak RSS.
+    bool cold = false;
+    bool coldTlb = false; // also thrash the TLB.
+    bool coldBranches = false; // also retrain the branch predictors.
+    size_t coldBytes = 0; // eviction buffer, 0 for twice the last level cache.
+    // reset the process' peak RSS at the start of each phase, so it is that phase's own. Only sound while no other phase runs in the process.
+    bool phasePeakRss = true;
+    // the known answers to v1 and v2 (see Golden). Every sample's answer is compared to them, after its timing, and wrong ones are counted.
+    std::array<std::optional<std::string>, 2> expected;
+};
 
 class Day {
 public:
@@ -22,23 +64,34 @@ public:
     virtual ~Day() = default;
     explicit Day(int number) : Day((number < 10 ? "day_0" : "day_") + std::to_string(number) + "/day" + std::to_string(number) + ".txt") {}
 
-    explicit Day(const std::string& inputFilePath) {
-        auto p = std::filesystem::path(inputFilePath).make_preferred();
-        text.open(root / p);
-        if (! text) {
-            throw std::invalid_argument(" could not read: " + (root/p).string());
-        }
-    }
+    explicit Day(const std::string& inputFilePath) : Day(MappedFile(root / std::filesystem::path(inputFilePath).make_preferred())) {}
+
+    explicit Day(MappedFile input) : file(std::move(input)), text(file.view()) {}
 
     virtual void v1() const = 0;
     virtual void v2() const = 0;
-    virtual void parse(std::ifstream& text) = 0;
+    virtual void parse(Input& input) = 0;
     virtual void parseBenchReset() = 0;
 
+    // whether the day implements save() and load(). Checked before prepare() touches the file system, so days without
+    // a snapshot format do not pay for a stat() in every parse sample.
+    [[nodiscard]] virtual bool hasSnapshotFormat() const { return false; }
+    // the parsed state, for a Snapshot that lets later runs on the same input skip parse().
+    virtual void save(Snapshot::Writer&) const {}
+    // the state save() wrote, in place of parse(). Only ever handed a snapshot this solver wrote, for this input, in this build.
+    virtual void load(Snapshot::Reader&) {}
+
+    // puts 's' in the result slot of the part this thread is running, see answer() and bench(). Integers and short text are kept
+    // without allocating (Result). With no slot, e.g. when a benchmark does not check answers, it is dropped.
     template<typename T> void reportSolution(const T& s) const {
-        solution_printer = [s](const char * prefix) {
-            std::cout << prefix << s << "\n";
-        };
+        if (! slot) return;
+        slot->set(s);
+    }
+
+    // memory for the temporary containers of one v1() or v2() call, e.g. std::pmr::set<int> seen(scratch()). It is rewound when
+    // the call returns, so nothing that outlives the call (the parsed input) may use it. Outside a solve, the default heap.
+    static std::pmr::memory_resource* scratch() {
+        return arena ? static_cast<std::pmr::memory_resource*>(arena) : std::pmr::get_default_resource();
     }
 
     static void assert(bool b, const std::string& r = "No reason given") {
@@ -47,51 +100,133 @@ public:
         throw std::logic_error("Assertion error, reason: " + r);
     }
 
-    void solve() {
+    // parses, then solves both parts and prints the answers. v1 and v2 are const and independent, so by default they run at the same
+    // time, and a solve takes as long as the slower part rather than both. 'concurrent' false keeps their diagnostics apart.
+    void solve(bool concurrent = true) {
+        { TRACE_ZONE("parse"); prepare(); }
+
+        auto part = [this](int n) {
+            TRACE_ZONE(n == 1 ? "v1" : "v2");
+            return answer(n);
+        };
+        std::string first, second;
+        if (concurrent) {
+            auto later = std::async(std::launch::async, part, 2);
+            first = part(1);
+            second = later.get();
+        } else {
+            first = part(1);
+            second = part(2);
+        }
+        std::cout << "v1: " << first << "\n";
+        std::cout << "v2: " << second << "\n";
+    }
+
+    struct Answers {
+        std::string v1;
+        std::string v2;
+    };
+
+    // like solve(), but hands the answers back instead of printing them.
+    Answers answers() {
+        prepare();
+        return { answer(1), answer(2) };
+    }
+
+    [[nodiscard]] std::string_view inputText() const { return file.view(); }
+
+    // parses the input. Once, before answer(). With snapshots on (setSnapshots), from the input's snapshot if it has a valid
+    // one, and otherwise writing one after parsing, for next time.
+    void prepare() {
+        if (! snapshots || ! hasSnapshotFormat() || file.path().empty()) {
+            parse(text);
+            return;
+        }
+
+        const auto path = Snapshot::pathFor(file.path());
+        const auto solver = Snapshot::solverId(typeid(*this).name());
+        if (auto snapshot = Snapshot::open(path, solver, file.view())) {
+            try {
+                auto reader = Snapshot::reader(*snapshot);
+                load(reader);
+                return;
+            } catch (const std::invalid_argument& e) {
+                LOG_INFO("ignoring snapshot " << path << ": " << e.what());
+                parseBenchReset(); // whatever load() got to.
+            }
+        }
+
         parse(text);
-        v1();
-        solution_printer("v1: ");
-        v2();
-        solution_printer("v2: ");
+        Snapshot::Writer writer;
+        save(writer);
+        Snapshot::write(path, solver, file.view(), writer);
+    }
+
+    // the answer to 'part' (1 or 2), as text. Its result slot belongs to this call, so any number of threads can be
+    // answering, the same part or not, on the same parsed input.
+    [[nodiscard]] std::string answer(int part) const {
+        if (part != 1 && part != 2) throw std::invalid_argument("no such part: " + std::to_string(part));
+
+        Result result;
+        Arena memory;
+        Rebind into(slot, &result);
+        Rebind scratchIn(arena, &memory);
+        part == 1 ? v1() : v2();
+        return result.str();
     }
 
     using StatTriplet = std::array<BenchmarkStats, 3>; // A surprise tool that will help us later.
 
     void benchmark(int sampleCount = 10'000, double reportEveryPct = 0.05) {
+        BenchConfig config;
+        config.maxSamples = sampleCount;
+        config.reportEveryPct = reportEveryPct;
+        benchmark(config);
+    }
+
+    void benchmark(const BenchConfig& config) {
         StatTriplet s;
-        benchmark(s, sampleCount, reportEveryPct, true);
+        benchmark(s, config, true);
     }
 
-    void benchmark(StatTriplet& outStats, int sampleCount, double reportEveryPct, bool printStats) {
-        auto bench_w_params = [sampleCount, reportEveryPct](auto& func, auto& stats, auto& str, auto& resetFunc){
-            bench(sampleCount, reportEveryPct, func, stats, str, resetFunc);
+    // 'onlyPhase' 0, 1 or 2 benchmarks just parse, v1 or v2, and leaves the other stats empty. -1 benchmarks all three.
+    void benchmark(StatTriplet& outStats, const BenchConfig& config, bool printStats, int onlyPhase = -1) {
+        Result answer; // one for all samples, so reporting into it never allocates after the first.
+        Arena memory; // the solvers' scratch(). Grown by their first calls, then rewound and reused by every call after.
+        auto bench_w_params = [&config, &answer, &memory](auto& func, auto& stats, auto& str, auto& resetFunc, bool batchable, int part = 0){
+            const bool check = part > 0 && config.expected[part - 1];
+            bench(config, func, stats, str, resetFunc, batchable, check ? &answer : nullptr, check ? &*config.expected[part - 1] : nullptr,
+                  part > 0 ? &memory : nullptr);
         };
 
-        auto f0 = [this]() { parse(this->text); };
+        auto f0 = [this]() { prepare(); }; // with snapshots on, this times loading the snapshot (after the first call writes it).
         auto f1 = [this]() { v1(); };
         auto f2 = [this]() { v2(); };
 
-        BenchmarkStats parse_stats(std::chrono::nanoseconds{1});
-        BenchmarkStats v1_stats(std::chrono::milliseconds{1});
-        BenchmarkStats v2_stats(std::chrono::milliseconds{1});
+        auto storage = config.streaming ? BenchmarkStats::Storage::STREAMING : BenchmarkStats::Storage::ALL_SAMPLES;
+        BenchmarkStats parse_stats(std::chrono::nanoseconds{1}, storage);
+        BenchmarkStats v1_stats(std::chrono::milliseconds{1}, storage);
+        BenchmarkStats v2_stats(std::chrono::milliseconds{1}, storage);
 
-        auto resetSolver = [this](){ solution_printer = {}; };
+        auto resetSolver = [](){}; // the solvers only ever report an answer, which bench() clears itself.
         auto resetParser = [this](){
-            text.clear();
-            text.seekg(0);
+            text.rewind();
             parseBenchReset(); // resets derived class structs that were parsed into memory.
         };
 
-        {
-            bench_w_params(f0, parse_stats, "parse", resetParser);
+        auto wanted = [onlyPhase](int phase) { return onlyPhase < 0 || onlyPhase == phase; };
+
+        if (wanted(0)) {
+            // parse has to be reset between every call, which costs more than most parses. Batching it would mostly measure the reset.
+            bench_w_params(f0, parse_stats, "parse", resetParser, false);
         }
-        {
+        if (wanted(1) || wanted(2)) {
             // before benchmarking these solvers, parse the text. They need it, or they operate on empty data.
             // Due to immutability, this has to be done only once.
             // Parse benching resets the parser each time, so we must do it at least once.
-            parse(text);
-            bench_w_params(f1, v1_stats, "v1", resetSolver);
-            bench_w_params(f2, v2_stats, "v2", resetSolver);
+            prepare();
+            if (wanted(1)) bench_w_params(f1, v1_stats, "v1", resetSolver, true, 1);
+            if (wanted(2)) bench_w_params(f2, v2_stats, "v2", resetSolver, true, 2);
         }
 
         if (printStats) {
@@ -109,42 +244,195 @@ public:
         Day::root = r;
     }
 
+    static void setSnapshots(bool on) {
+        Day::snapshots = on;
+    }
+
 private:
-    std::ifstream text;
+    MappedFile file; // read once, in the constructor. Parsing then only ever touches memory.
+    Input text; // over 'file'.
+
+    // set by answer() or bench(), for the duration of one v1() or v2() on this thread.
+    static inline thread_local Result* slot = nullptr;
+    static inline thread_local Arena* arena = nullptr;
 
-    mutable PrinterCallback solution_printer;
+    // points 'where' (slot or arena) at 'to' for as long as it lives.
+    template<typename T>
+    struct Rebind {
+        Rebind(T*& at, T* to) : where(at), previous(at) { at = to; }
+        ~Rebind() { where = previous; }
+        Rebind(const Rebind&) = delete;
+        Rebind& operator=(const Rebind&) = delete;
+
+        T*& where;
+        T* previous;
+    };
 
     static std::filesystem::path root;
+    static inline bool snapshots = false;
 
     static void bench(
-        int sampleCount,
-        double reportEveryPct,
+        const BenchConfig& config,
         const std::function<void()>& f,
         BenchmarkStats& s,
         const std::string& functionName,
         // resets any values that f needs to be reset. Used for the base class.
         // This should not be necessary for anything else though. Derived Solvers should NOT mutate state!
-        const std::function<void()>& resetter = [](){}
+        const std::function<void()>& resetter = [](){},
+        // f may be called several times in a row without resetter() in between. True for the solvers, which are const.
+        bool batchable = false,
+        // where f reports its answer, and what it should be. Checked after each sample's timing, so the check is not measured.
+        Result* result = nullptr,
+        const std::string* expected = nullptr,
+        // f's scratch(), rewound after every call of f. Its memory is kept for the whole phase.
+        Arena* memory = nullptr
     ) {
+        Rebind into(slot, result);
+        Rebind scratchIn(arena, memory);
+        auto rewind = [memory]() { if (memory) memory->rewind(); };
         s.reset();
-        s.reserve(sampleCount);
-        const double stepSize = sampleCount * reportEveryPct;
-        double targetForReport = stepSize;
-        std::cout << "[" << functionName << "] Benchmark: ";
-        for (int i = 0; i < sampleCount; ++i) {
-            auto start = chrono::steady_clock::now();
+        s.reserve(config.maxSamples);
+        const auto phaseStart = chrono::steady_clock::now();
+        auto overBudget = [&config, phaseStart]() {
+            return chrono::steady_clock::now() - phaseStart >= config.budget;
+        };
+
+        const bool peakWasReset = config.phasePeakRss && Memory::resetPeak();
+        const auto faultsBefore = Memory::faults();
+
+        int warmed = 0;
+        for (; warmed < config.warmup && ! overBudget(); ++warmed) {
             f();
-            auto end = chrono::steady_clock::now();
-            s.measurement(end - start);
+            rewind();
+            resetter();
+        }
+
+        // calls back to back would warm each other up, so a cold sample is always a single call.
+        const int batch = batchable && ! config.cold ? callsPerSample(f, config.batchTarget, rewind) : 1;
+        const Time overhead = batch > 1 ? loopOverhead(batch) : Time{0};
+        s.batched(batch);
+
+        std::optional<PerfCounters> perf;
+        if (config.counters) {
+            perf.emplace();
+            if (! perf->available()) {
+                perf.reset();
+                static std::atomic_flag warned;
+                if (! warned.test_and_set()) {
+                    std::cout << "Warning: hardware counters are not available (see /proc/sys/kernel/perf_event_paranoid). Timing only.\n";
+                }
+            }
+        }
+
+        std::optional<CacheEvictor> evict;
+        if (config.cold) evict.emplace(config.coldBytes, config.coldTlb, config.coldBranches);
+
+        const bool allocs = config.allocations && Alloc::compiled();
+        if (config.allocations && ! allocs) {
+            static std::atomic_flag warned;
+            if (! warned.test_and_set()) {
+                std::cout << "Warning: allocation counting was not compiled in (AOC_TRACK_ALLOCATIONS=OFF). Timing only.\n";
+            }
+        }
+        // the stats' own vectors were reserved above, so tracking around the samples does not see the bookkeeping.
+        Alloc::track(allocs);
+
+        const bool report = config.reportEveryPct > 0;
+        const double stepSize = config.maxSamples * config.reportEveryPct;
+        double targetForReport = stepSize;
+        if (report) std::cout << "[" << functionName << "] Benchmark: ";
+        auto why = BenchmarkStats::StopReason::SAMPLE_COUNT;
+        for (int i = 0; i < config.maxSamples; ++i) {
+            if (evict) (*evict)();
+            PerfCounters::Reading before {};
+            if (perf) before = perf->read();
+            Alloc::Counters heapBefore {};
+            if (allocs) {
+                Alloc::resetPeak();
+                heapBefore = Alloc::snapshot();
+            }
+            if (result) result->clear();
+            if (batch == 1) {
+                auto start = chrono::steady_clock::now();
+                f();
+                auto end = chrono::steady_clock::now();
+                s.measurement(end - start);
+                rewind();
+            } else {
+                auto start = chrono::steady_clock::now();
+                // rewinding is two stores, cheap enough to leave in the timed loop. Without it a batch would grow the arena batch-fold.
+                for (int k = 0; k < batch; ++k) {
+                    f();
+                    rewind();
+                }
+                auto end = chrono::steady_clock::now();
+                s.measurement(std::max(Time{0}, end - start - overhead) / batch);
+            }
+            if (allocs) {
+                auto heapAfter = Alloc::snapshot();
+                Alloc::Counters delta { heapAfter.allocations - heapBefore.allocations, heapAfter.bytes - heapBefore.bytes };
+                s.allocations(delta, heapAfter.peak - heapBefore.live, batch);
+            }
+            if (perf) s.counters(PerfCounters::delta(before, perf->read()), batch, *perf);
+            if (result && expected) s.verified(*result, result->matches(*expected));
             resetter();
 
-            if (i == static_cast<int>(targetForReport)) {
-                auto pct = static_cast<double>(i) / sampleCount;
+            if (report && i == static_cast<int>(targetForReport)) {
+                auto pct = static_cast<double>(i) / config.maxSamples;
                 std::cout << (100 * pct) << "%  ";
                 std::cout.flush();
                 targetForReport += stepSize;
             }
+
+            // at least one sample is always taken, even if the warmup ate the entire budget. A phase with no samples has no stats.
+            if (i + 1 < config.maxSamples) {
+                if (config.targetRse > 0 && i + 1 >= config.minSamples && s.relative_std_error() <= config.targetRse) {
+                    why = BenchmarkStats::StopReason::CONVERGED;
+                    break;
+                }
+                if (overBudget()) {
+                    why = BenchmarkStats::StopReason::BUDGET;
+                    break;
+                }
+            }
+        }
+        Alloc::track(false);
+        s.memory(Memory::since(faultsBefore, peakWasReset));
+        s.stopped(why, warmed);
+        if (report) std::cout << "\n";
+    }
+
+    // Smallest power of 2 calls of f that take at least 'target' together. 1 if f is slow enough on its own, or batching is off.
+    template<typename Rewind>
+    static int callsPerSample(const std::function<void()>& f, chrono::nanoseconds target, const Rewind& rewind) {
+        constexpr int maxBatch = 1 << 20;
+        if (target.count() <= 0) return 1;
+
+        int k = 1;
+        while (k < maxBatch) {
+            auto start = chrono::steady_clock::now();
+            for (int i = 0; i < k; ++i) {
+                f();
+                rewind();
+            }
+            auto end = chrono::steady_clock::now();
+            if (end - start >= target) break;
+            k *= 2;
+        }
+        return k;
+    }
+
+    // What a batch of 'k' calls costs when the call itself does nothing: the std::function dispatch, the loop, and the two clock reads.
+    // Best of several tries, since this should be the floor. Anything above it is noise we do not want to subtract.
+    static Time loopOverhead(int k) {
+        static const std::function<void()> nothing = [](){};
+        Time best = Time::max();
+        for (int attempt = 0; attempt < 31; ++attempt) {
+            auto start = chrono::steady_clock::now();
+            for (int i = 0; i < k; ++i) nothing();
+            auto end = chrono::steady_clock::now();
+            best = std::min(best, end - start);
         }
-        std::cout << "\n";
+        return best;
     }
 };
\ No newline at end of file
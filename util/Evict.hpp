@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+/**
+ * Makes the next call run cold, like the first call of a fresh request would: nothing of its data in the caches,
+ * its pages not in the TLB, the branch predictors trained on something else.
+ *
+ * Caches are flushed by writing a buffer larger than the last level cache, one byte per cache line. Dirty lines of our own
+ * make the caches throw everything else out, prefetchers or not. Optionally, the TLB is thrashed by touching the buffer's pages
+ * in random order, and the branch predictors by running data-dependent and indirect branches on random data.
+ * None of this is timed by Day::bench, but it is slow: a pass over the default buffer can take tens of milliseconds.
+ */
+class CacheEvictor {
+public:
+    // 'bytes' 0 means twice the last level cache, capped at 1 GiB (the reported "LLC" of a VM can be the entire socket's).
+    explicit CacheEvictor(size_t bytes = 0, bool tlb = false, bool branches = false) :
+        buffer(bytes > 0 ? bytes : std::min<size_t>(2 * llcBytes(), size_t{1} << 30), 1),
+        branches(branches)
+    {
+        std::mt19937 rng(0xc01d);
+        if (tlb) {
+            pages.resize(buffer.size() / PAGE);
+            std::iota(pages.begin(), pages.end(), 0);
+            std::ranges::shuffle(pages, rng);
+        }
+        if (branches) {
+            noise.resize(1 << 16);
+            std::ranges::generate(noise, [&rng]() { return static_cast<uint8_t>(rng()); });
+        }
+    }
+
+    void operator()() {
+        for (size_t i = 0; i < buffer.size(); i += LINE) ++buffer[i];
+
+        uint64_t acc = 0;
+        for (uint32_t page : pages) acc += buffer[static_cast<size_t>(page) * PAGE + (page % (PAGE / LINE)) * LINE];
+
+        if (branches) {
+            static constexpr uint64_t (*targets[])(uint64_t) = {
+                [](uint64_t x) { return x + 1; }, [](uint64_t x) { return x ^ 0x55; }, [](uint64_t x) { return x * 3; }, [](uint64_t x) { return x >> 1; },
+                [](uint64_t x) { return x - 7; }, [](uint64_t x) { return ~x; }, [](uint64_t x) { return x << 2; }, [](uint64_t x) { return x | 9; },
+            };
+            for (uint8_t b : noise) {
+                if (b & 1) acc += b; else acc ^= b; // a coin flip each time, to the predictor.
+                acc = targets[b >> 5](acc);
+            }
+        }
+        sink = sink + acc; // so none of the above is optimised away.
+    }
+
+    [[nodiscard]] size_t size() const { return buffer.size(); }
+
+    // size of the largest cache of cpu0, from sysfs, or sysconf. 32 MiB if neither knows.
+    static size_t llcBytes() {
+        size_t largest = 0;
+        for (int index = 0; index < 8; ++index) {
+            std::ifstream f("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/size");
+            std::string size;
+            if (! (f >> size) || size.empty()) continue;
+
+            size_t value = std::stoull(size);
+            switch (size.back()) {
+                case 'K': value <<= 10; break;
+                case 'M': value <<= 20; break;
+                case 'G': value <<= 30; break;
+            }
+            largest = std::max(largest, value);
+        }
+#ifdef _SC_LEVEL3_CACHE_SIZE
+        if (largest == 0) largest = std::max<long>(0, sysconf(_SC_LEVEL3_CACHE_SIZE));
+#endif
+        return largest > 0 ? largest : size_t{32} << 20;
+    }
+
+private:
+    static constexpr size_t LINE = 64;
+    static constexpr size_t PAGE = 4096;
+
+    std::vector<uint8_t> buffer;
+    std::vector<uint32_t> pages; // in random order, empty unless 'tlb'.
+    std::vector<uint8_t> noise; // empty unless 'branches'.
+    bool branches;
+    volatile uint64_t sink = 0;
+};
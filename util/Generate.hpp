@@ -0,0 +1,681 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * Synthetic puzzle inputs of any size, for seeing how the solvers scale beyond the one checked-in input.
+ *
+ * generate(day, scale, seed) gives the text of a valid input for that day, in the same format as dayN.txt and with the same
+ * structure (e.g. the tower of day 7 is balanced but for one program, the delay of day 13 exists, the path of day 19 is one line).
+ * What 'scale' counts differs per day, see unit(). Some inputs have a fixed size in the puzzle itself (day 6 always has 16 banks,
+ * day 15 is two numbers); those ignore the scale and only vary with the seed.
+ *
+ * The same day, scale and seed give the same bytes on every platform and standard library.
+ */
+namespace Generate {
+
+// the standard distributions are implementation-defined, so every draw is derived from the raw engine output here.
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : engine(seed) {}
+
+    uint64_t next() { return engine(); }
+
+    // uniform in [lo, hi]. Multiply-shift, its bias is far below anything an input generator cares about.
+    int64_t between(int64_t lo, int64_t hi) {
+        if (hi < lo) throw std::logic_error("between(): empty range");
+        auto range = static_cast<unsigned __int128>(static_cast<uint64_t>(hi - lo) + 1);
+        return lo + static_cast<int64_t>((range * next()) >> 64);
+    }
+
+    bool chance(double p) { return static_cast<double>(next() >> 11) * 0x1.0p-53 < p; }
+
+    char lower() { return static_cast<char>('a' + between(0, 25)); }
+    char upper() { return static_cast<char>('A' + between(0, 25)); }
+
+    std::string word(int minLength, int maxLength) {
+        std::string w(between(minLength, maxLength), ' ');
+        for (auto& c : w) c = lower();
+        return w;
+    }
+
+    template<typename Container>
+    void shuffle(Container& v) {
+        for (size_t i = v.size(); i > 1; --i) {
+            std::swap(v[i - 1], v[between(0, static_cast<int64_t>(i) - 1)]);
+        }
+    }
+
+private:
+    std::mt19937_64 engine;
+};
+
+// joins with a separator, which is how most of the inputs are laid out.
+template<typename T, typename F>
+std::string join(const std::vector<T>& items, const std::string& separator, F&& format) {
+    std::string result;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (i > 0) result += separator;
+        result += format(items[i]);
+    }
+    return result;
+}
+
+inline std::string number(int64_t v) { return std::to_string(v); }
+
+// the checked-in inputs do not end in a newline, and some parsers (day 22, day 25) rely on that.
+inline std::string lines(const std::vector<std::string>& rows) {
+    return join(rows, "\n", [](const std::string& s) -> const std::string& { return s; });
+}
+
+inline int asInt(size_t scale, const char* what) {
+    if (scale > INT_MAX) throw std::invalid_argument(std::string(what) + " does not fit in an int");
+    return static_cast<int>(scale);
+}
+
+// n digits, with runs of repeats for part 1 to find. Even, as part 2 looks halfway around.
+inline std::string day1(size_t n, Rng& rng) {
+    std::string digits(std::max<size_t>(2, n + n % 2), '0');
+    char previous = '1';
+    for (auto& c : digits) {
+        c = rng.chance(0.25) ? previous : static_cast<char>('1' + rng.between(0, 8));
+        previous = c;
+    }
+    return digits;
+}
+
+// n rows of 16. Every row has exactly one pair where one divides the other, part 2 throws otherwise.
+inline std::string day2(size_t n, Rng& rng) {
+    std::vector<std::string> rows;
+    for (size_t r = 0; r < n; ++r) {
+        const int64_t high = rng.between(100, 6000);
+        const int64_t a = rng.between(2, high / 4);
+        std::vector<int64_t> row { a, a * rng.between(2, std::max<int64_t>(2, high / a)) };
+
+        auto divides = [](int64_t x, int64_t y) { return x % y == 0 || y % x == 0; };
+        while (row.size() < 16) {
+            int64_t candidate = rng.between(high / 10 + 1, high);
+            if (std::ranges::none_of(row, [&](int64_t v) { return divides(v, candidate); })) {
+                row.emplace_back(candidate);
+            }
+        }
+        rng.shuffle(row);
+        rows.emplace_back(join(row, "\t", number));
+    }
+    return lines(rows);
+}
+
+// the square to walk to from the center, and the value part 2 has to exceed.
+inline std::string day3(size_t n, Rng&) {
+    return number(std::max(2, asInt(n, "the square")));
+}
+
+// n passphrases, some with a repeated word and some with an anagram of one.
+inline std::string day4(size_t n, Rng& rng) {
+    std::vector<std::string> rows;
+    for (size_t r = 0; r < n; ++r) {
+        std::vector<std::string> words;
+        const auto count = rng.between(3, 11);
+        while (std::ssize(words) < count) {
+            if (! words.empty() && rng.chance(0.03)) {
+                words.emplace_back(words.at(rng.between(0, std::ssize(words) - 1)));
+            } else if (! words.empty() && rng.chance(0.05)) {
+                auto anagram = words.at(rng.between(0, std::ssize(words) - 1));
+                rng.shuffle(anagram);
+                words.emplace_back(std::move(anagram));
+            } else {
+                words.emplace_back(rng.word(2, 7));
+            }
+        }
+        rows.emplace_back(join(words, " ", [](const std::string& s) -> const std::string& { return s; }));
+    }
+    return lines(rows);
+}
+
+// n jump offsets, mostly backwards, further back the further down the list. Always escapes, the offsets only grow (part 1)
+// or are pulled towards 3 (part 2).
+inline std::string day5(size_t n, Rng& rng) {
+    std::vector<int64_t> offsets;
+    for (size_t i = 0; i < n; ++i) {
+        offsets.emplace_back(rng.between(-static_cast<int64_t>(i), 2));
+    }
+    return join(offsets, "\n", number);
+}
+
+// always 16 banks. The solver packs a bank in 6 bits, which the puzzle's small block counts stay well within.
+inline std::string day6(size_t, Rng& rng) {
+    std::vector<int64_t> banks;
+    for (int i = 0; i < 16; ++i) banks.emplace_back(rng.between(0, 15));
+    return join(banks, "\t", number);
+}
+
+// a tower of n programs, balanced but for one program that is off by a few. The solver's part 2 starts at a program called
+// "lahahn" (the answer was worked out by hand), so one of the programs that holds others up is given that name.
+inline std::string day7(size_t n, Rng& rng) {
+    n = std::max<size_t>(n, 4);
+    std::vector<std::vector<size_t>> children(n);
+    std::vector<size_t> queue { 0 };
+    size_t next = 1;
+    for (size_t at = 0; next < n; ++at) {
+        const size_t p = queue.at(at);
+        if (p != 0 && at + 1 < queue.size() && rng.chance(0.3)) continue; // stays a leaf
+        const auto count = std::min<size_t>(rng.between(3, 7), n - next);
+        for (size_t i = 0; i < count; ++i) {
+            children[p].emplace_back(next);
+            queue.emplace_back(next++);
+        }
+    }
+
+    // bottom-up, children come after their parent. Lighter subtrees are made as heavy as the heaviest sibling.
+    std::vector<int64_t> weight(n), total(n);
+    for (size_t i = n; i-- > 0;) {
+        weight[i] = rng.between(1, 99);
+        int64_t heaviest = 0;
+        for (auto c : children[i]) heaviest = std::max(heaviest, total[c]);
+        for (auto c : children[i]) {
+            weight[c] += heaviest - total[c];
+            total[c] = heaviest;
+        }
+        total[i] = weight[i] + heaviest * static_cast<int64_t>(children[i].size());
+    }
+
+    // the odd one out needs at least two siblings, or it is not clear which of the two is wrong.
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < n; ++i) {
+        if (children[i].size() >= 3) candidates.insert(candidates.end(), children[i].begin(), children[i].end());
+    }
+    const size_t odd = candidates.at(rng.between(0, std::ssize(candidates) - 1));
+    const int64_t delta = rng.between(1, 9);
+    weight[odd] += (weight[odd] > delta && rng.chance(0.5)) ? -delta : delta;
+
+    std::vector<std::string> names(n);
+    std::set<std::string> taken { "lahahn" };
+    for (auto& name : names) {
+        do { name = rng.word(4, 7); } while (! taken.insert(name).second);
+    }
+    std::vector<size_t> holders;
+    for (size_t i = 0; i < n; ++i) {
+        if (! children[i].empty()) holders.emplace_back(i);
+    }
+    names[holders.at(rng.between(0, std::ssize(holders) - 1))] = "lahahn";
+
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = i;
+    rng.shuffle(order);
+    return lines([&] {
+        std::vector<std::string> rows;
+        for (auto i : order) {
+            std::string row = names[i] + " (" + number(weight[i]) + ")";
+            if (! children[i].empty()) {
+                row += " -> " + join(children[i], ", ", [&](size_t c) -> const std::string& { return names[c]; });
+            }
+            rows.emplace_back(std::move(row));
+        }
+        return rows;
+    }());
+}
+
+// n instructions on a couple of dozen registers, mostly compared against small values.
+inline std::string day8(size_t n, Rng& rng) {
+    std::set<std::string> unique;
+    while (unique.size() < 26) unique.insert(rng.word(1, 3));
+    const std::vector<std::string> registers(unique.begin(), unique.end());
+    const std::vector<std::string> comparators { "<", ">", "<=", ">=", "==", "!=" };
+
+    auto any = [&](const std::vector<std::string>& from) -> const std::string& { return from.at(rng.between(0, std::ssize(from) - 1)); };
+
+    std::vector<std::string> rows;
+    for (size_t i = 0; i < n; ++i) {
+        std::string row = any(registers) + (rng.chance(0.5) ? " inc " : " dec ") + number(rng.between(-1000, 1000));
+        row += " if " + any(registers) + " " + any(comparators) + " " + number(rng.chance(0.9) ? rng.between(-10, 10) : rng.between(-5000, 5000));
+        rows.emplace_back(std::move(row));
+    }
+    return lines(rows);
+}
+
+// a stream of about n characters: nested groups of garbage and groups, with '!' cancelling characters inside the garbage.
+inline std::string day9(size_t n, Rng& rng) {
+    constexpr int deepest = 12;
+    constexpr std::string_view filler = "aeiou'\"{}<,!";
+
+    std::string stream = "{";
+    std::vector<bool> empty { true }; // per open group, if nothing is in it yet (no comma needed).
+    auto separate = [&] {
+        if (! empty.back()) stream += ',';
+        empty.back() = false;
+    };
+
+    while (! empty.empty()) {
+        const bool full = stream.size() >= n;
+        const double roll = static_cast<double>(rng.between(0, 999)) / 1000;
+        if (full || (empty.size() > 1 && roll < 0.35)) {
+            stream += '}';
+            empty.pop_back();
+        } else if (roll < 0.65 && std::ssize(empty) < deepest) {
+            separate();
+            stream += '{';
+            empty.emplace_back(true);
+        } else {
+            separate();
+            stream += '<';
+            for (auto length = rng.between(0, 20); length > 0; --length) {
+                char c = filler[rng.between(0, std::ssize(filler) - 1)];
+                stream += c;
+                if (c == '!') stream += rng.chance(0.5) ? '!' : filler[rng.between(0, std::ssize(filler) - 1)];
+            }
+            stream += '>';
+        }
+    }
+    return stream;
+}
+
+// n lengths for the knot, none longer than its 256 marks.
+inline std::string day10(size_t n, Rng& rng) {
+    std::vector<int64_t> lengths;
+    for (size_t i = 0; i < std::max<size_t>(n, 1); ++i) lengths.emplace_back(rng.between(0, 255));
+    return join(lengths, ",", number);
+}
+
+// n steps on the hex grid, drifting in a direction of the seed's choosing.
+inline std::string day11(size_t n, Rng& rng) {
+    const std::vector<std::string> directions { "n", "ne", "se", "s", "sw", "nw" };
+    std::vector<int64_t> weights;
+    int64_t sum = 0;
+    for (size_t i = 0; i < directions.size(); ++i) weights.emplace_back(sum += rng.between(1, 10));
+
+    std::vector<size_t> steps;
+    for (size_t i = 0; i < std::max<size_t>(n, 1); ++i) {
+        const int64_t roll = rng.between(0, sum - 1);
+        steps.emplace_back(std::ranges::upper_bound(weights, roll) - weights.begin());
+    }
+    return join(steps, ",", [&](size_t d) -> const std::string& { return directions[d]; });
+}
+
+// n programs in many small groups of connected programs, as in the puzzle. A program on its own is connected to itself.
+inline std::string day12(size_t n, Rng& rng) {
+    const auto count = asInt(std::max<size_t>(n, 1), "the program count");
+    std::vector<int> order(count);
+    for (int i = 0; i < count; ++i) order[i] = i;
+    rng.shuffle(order);
+
+    std::vector<std::pair<int, int>> pipes;
+    auto connect = [&](int a, int b) {
+        pipes.emplace_back(a, b);
+        pipes.emplace_back(b, a);
+    };
+    for (int start = 0; start < count;) {
+        const int size = static_cast<int>(std::min<int64_t>(rng.between(1, 20), count - start));
+        const int* group = order.data() + start;
+        if (size == 1) connect(group[0], group[0]);
+        for (int i = 1; i < size; ++i) connect(group[i], group[rng.between(0, i - 1)]);
+        for (int extra = size / 2; extra > 0; --extra) connect(group[rng.between(0, size - 1)], group[rng.between(0, size - 1)]);
+        start += size;
+    }
+    std::ranges::sort(pipes);
+    pipes.erase(std::unique(pipes.begin(), pipes.end()), pipes.end());
+
+    std::string result;
+    for (size_t i = 0; i < pipes.size();) {
+        const int from = pipes[i].first;
+        result += (i > 0 ? "\n" : "") + number(from) + " <-> ";
+        for (bool first = true; i < pipes.size() && pipes[i].first == from; ++i, first = false) {
+            result += (first ? "" : ", ") + number(pipes[i].second);
+        }
+    }
+    return result;
+}
+
+// n firewall layers. Part 2 searches for a delay that passes every scanner, and loops forever if there is none, so a delay is
+// picked first and every range chosen so that its scanner is away from the top when the packet passes at that delay.
+inline std::string day13(size_t n, Rng& rng) {
+    const int64_t delay = rng.between(100'000, 4'000'000);
+    std::vector<std::string> rows;
+    int64_t depth = 0;
+    for (size_t i = 0; i < std::max<size_t>(n, 1); ++i) {
+        int64_t range;
+        do {
+            range = rng.chance(0.6) ? 2 * rng.between(1, 7) : rng.between(2, 20);
+        } while ((delay + depth) % (2 * (range - 1)) == 0);
+        rows.emplace_back(number(depth) + ": " + number(range));
+        depth += rng.between(1, 3);
+    }
+    return lines(rows);
+}
+
+// a key of n letters. The grid is 128 knot hashes of it whatever the length, so only the hashing gets slower.
+inline std::string day14(size_t n, Rng& rng) {
+    return rng.word(static_cast<int>(std::max<size_t>(n, 1)), static_cast<int>(std::max<size_t>(n, 1)));
+}
+
+// two starting values. The solver runs the generators a fixed number of rounds.
+inline std::string day15(size_t, Rng& rng) {
+    return "Generator A starts with " + number(rng.between(1, 999)) + "\nGenerator B starts with " + number(rng.between(1, 999));
+}
+
+// n dance moves for the 16 programs.
+inline std::string day16(size_t n, Rng& rng) {
+    std::vector<std::string> moves;
+    for (size_t i = 0; i < std::max<size_t>(n, 1); ++i) {
+        const int64_t a = rng.between(0, 15);
+        const int64_t b = (a + rng.between(1, 15)) % 16;
+        switch (rng.between(0, 2)) {
+            case 0: moves.emplace_back("s" + number(rng.between(1, 15))); break;
+            case 1: moves.emplace_back("x" + number(a) + "/" + number(b)); break;
+            default: moves.emplace_back(std::string("p") + static_cast<char>('a' + a) + "/" + static_cast<char>('a' + b)); break;
+        }
+    }
+    return join(moves, ",", [](const std::string& s) -> const std::string& { return s; });
+}
+
+// the step size. The solver spins a fixed number of times.
+inline std::string day17(size_t, Rng& rng) {
+    return number(rng.between(300, 399));
+}
+
+// the puzzle's own program: it sends n pseudo-random numbers (seeded from 'p'), then both copies bubble sort them through
+// their queues until a pass swaps nothing. Part 2 exchanges on the order of n squared messages.
+inline std::string day18(size_t n, Rng& rng) {
+    const int count = std::max(2, asInt(n, "the number count"));
+    return lines({
+        "set i 31", "set a 1", "mul p 17", "jgz p p", "mul a 2", "add i -1", "jgz i -2", "add a -1",
+        "set i " + number(count), "set p " + number(rng.between(100, 999)),
+        "mul p 8505", "mod p a", "mul p 129749", "add p 12345", "mod p a", "set b p", "mod b 10000", "snd b", "add i -1", "jgz i -9",
+        "jgz a 3", "rcv b", "jgz b -1", "set f 0",
+        "set i " + number(count - 1),
+        "rcv a", "rcv b", "set p a", "mul p -1", "add p b", "jgz p 4", "snd a", "set a b", "jgz 1 3", "snd b", "set f 1",
+        "add i -1", "jgz i -11", "snd a", "jgz f -16", "jgz a -19",
+    });
+}
+
+// a single winding path through about n corners and crossings-free straights, with letters along the way and at its end.
+// The path is the outline of a random maze (a spanning tree of a grid of cells): walking around a tree visits every corner of
+// every cell once, so the outline is one long loop that never touches itself. It is cut open at the top left, where it enters
+// from the first row. Corners are spaced out by at least one character, so a '+' never has a path next to it that it does
+// not turn into, which the solver relies on.
+inline std::string day19(size_t n, Rng& rng) {
+    const size_t cells = std::max<size_t>(n / 4, 1);
+    const auto w = std::max<size_t>(static_cast<size_t>(std::sqrt(static_cast<double>(cells))), 1);
+    const auto h = std::max<size_t>(cells / w, 1);
+
+    // randomised depth first search, for long corridors.
+    std::vector<bool> linkRight(w * h), linkDown(w * h), visited(w * h);
+    std::vector<size_t> stack { 0 };
+    visited[0] = true;
+    while (! stack.empty()) {
+        const size_t c = stack.back();
+        const size_t x = c % w, y = c / w;
+        std::vector<size_t> open;
+        if (x > 0 && ! visited[c - 1]) open.emplace_back(c - 1);
+        if (x + 1 < w && ! visited[c + 1]) open.emplace_back(c + 1);
+        if (y > 0 && ! visited[c - w]) open.emplace_back(c - w);
+        if (y + 1 < h && ! visited[c + w]) open.emplace_back(c + w);
+        if (open.empty()) {
+            stack.pop_back();
+            continue;
+        }
+        const size_t to = open.at(rng.between(0, std::ssize(open) - 1));
+        if (to == c + 1) linkRight[c] = true;
+        if (to + 1 == c) linkRight[to] = true;
+        if (to == c + w) linkDown[c] = true;
+        if (to + w == c) linkDown[to] = true;
+        visited[to] = true;
+        stack.emplace_back(to);
+    }
+
+    // corners: 2x2 per cell. An edge to the right or down of each corner, wherever the outline goes.
+    const size_t cw = 2 * w, ch = 2 * h;
+    std::vector<bool> right(cw * ch), down(cw * ch);
+    auto corner = [cw](size_t x, size_t y) { return y * cw + x; };
+    for (size_t y = 0; y < h; ++y) {
+        for (size_t x = 0; x < w; ++x) {
+            const size_t c = y * w + x, X = 2 * x, Y = 2 * y;
+            if (y == 0 || ! linkDown[c - w]) right[corner(X, Y)] = true;
+            if (x == 0 || ! linkRight[c - 1]) down[corner(X, Y)] = true;
+            if (linkDown[c]) {
+                down[corner(X, Y + 1)] = down[corner(X + 1, Y + 1)] = true;
+            } else {
+                right[corner(X, Y + 1)] = true;
+            }
+            if (linkRight[c]) {
+                right[corner(X + 1, Y)] = right[corner(X + 1, Y + 1)] = true;
+            } else {
+                down[corner(X + 1, Y)] = true;
+            }
+        }
+    }
+    right[corner(0, 0)] = false; // cut open: starts at (0, 0) coming from above, ends at (1, 0).
+
+    std::vector<size_t> column(cw), row(ch);
+    column[0] = 1;
+    row[0] = 1;
+    for (size_t x = 1; x < cw; ++x) column[x] = column[x - 1] + rng.between(2, 6);
+    for (size_t y = 1; y < ch; ++y) row[y] = row[y - 1] + rng.between(2, 6);
+
+    std::vector<std::string> grid(row.back() + 2, std::string(column.back() + 2, ' '));
+    grid[0][column[0]] = '|';
+    std::vector<std::pair<size_t, size_t>> straights;
+    for (size_t y = 0; y < ch; ++y) {
+        for (size_t x = 0; x < cw; ++x) {
+            const bool horizontal = right[corner(x, y)] || (x > 0 && right[corner(x - 1, y)]);
+            const bool vertical = down[corner(x, y)] || (y > 0 && down[corner(x, y - 1)]) || (x == 0 && y == 0);
+            grid[row[y]][column[x]] = horizontal && vertical ? '+' : (horizontal ? '-' : '|');
+            if (! (horizontal && vertical) && (x > 1 || y > 0)) straights.emplace_back(row[y], column[x]);
+            if (right[corner(x, y)]) {
+                for (size_t i = column[x] + 1; i < column[x + 1]; ++i) grid[row[y]][i] = '-';
+            }
+            if (down[corner(x, y)]) {
+                for (size_t i = row[y] + 1; i < row[y + 1]; ++i) grid[i][column[x]] = '|';
+            }
+        }
+    }
+    for (size_t letters = std::max<size_t>(10, n / 500); letters > 0 && ! straights.empty(); --letters) {
+        auto [r, c] = straights.at(rng.between(0, std::ssize(straights) - 1));
+        grid[r][c] = rng.upper();
+    }
+    grid[row[0]][column[1]] = rng.upper();
+    return lines(grid);
+}
+
+// n particles. About a quarter of them are in groups that meet at the same place and tick, for part 2 to remove.
+inline std::string day20(size_t n, Rng& rng) {
+    using XYZ = std::array<int64_t, 3>;
+    auto format = [](const XYZ& v) { return "<" + number(v[0]) + "," + number(v[1]) + "," + number(v[2]) + ">"; };
+
+    const size_t count = std::max<size_t>(n, 1);
+    std::vector<std::string> rows;
+    while (rows.size() < count) {
+        if (rng.chance(0.25)) {
+            const int64_t t = rng.between(5, 40);
+            const XYZ meet { rng.between(-1000, 1000), rng.between(-1000, 1000), rng.between(-1000, 1000) };
+            for (auto group = rng.between(2, 4); group > 0 && rows.size() < count; --group) {
+                XYZ p, v, a;
+                for (int i = 0; i < 3; ++i) {
+                    v[i] = rng.between(-100, 100);
+                    a[i] = rng.between(-10, 10);
+                    p[i] = meet[i] - v[i] * t - a[i] * t * (t + 1) / 2; // velocity updates before position, every tick.
+                }
+                rows.emplace_back("p=" + format(p) + ", v=" + format(v) + ", a=" + format(a));
+            }
+        } else {
+            const XYZ p { rng.between(-5000, 5000), rng.between(-5000, 5000), rng.between(-5000, 5000) };
+            const XYZ v { rng.between(-150, 150), rng.between(-150, 150), rng.between(-150, 150) };
+            const XYZ a { rng.between(-15, 15), rng.between(-15, 15), rng.between(-15, 15) };
+            rows.emplace_back("p=" + format(p) + ", v=" + format(v) + ", a=" + format(a));
+        }
+    }
+    return lines(rows);
+}
+
+// one rule for every 2x2 and 3x3 pattern up to rotation and flipping (6 and 102 of them), with random outputs.
+// The solver enhances a fixed number of times, so the scale is ignored.
+inline std::string day21(size_t, Rng& rng) {
+    auto pattern = [](uint32_t bits, int size) {
+        std::string s;
+        for (int r = 0; r < size; ++r) {
+            if (r > 0) s += '/';
+            for (int c = 0; c < size; ++c) s += (bits >> (r * size + c)) & 1 ? '#' : '.';
+        }
+        return s;
+    };
+    auto transform = [](uint32_t bits, int size, bool flip, int turns) {
+        uint32_t result = 0;
+        for (int r = 0; r < size; ++r) {
+            for (int c = 0; c < size; ++c) {
+                int tr = r, tc = flip ? size - 1 - c : c;
+                for (int i = 0; i < turns; ++i) std::tie(tr, tc) = std::make_pair(tc, size - 1 - tr);
+                result |= ((bits >> (r * size + c)) & 1u) << (tr * size + tc);
+            }
+        }
+        return result;
+    };
+
+    std::vector<std::string> rows;
+    for (int size : { 2, 3 }) {
+        for (uint32_t bits = 0; bits < (1u << (size * size)); ++bits) {
+            bool canonical = true;
+            for (int i = 0; i < 8 && canonical; ++i) canonical = transform(bits, size, i >= 4, i % 4) >= bits;
+            if (! canonical) continue;
+
+            const uint32_t output = static_cast<uint32_t>(rng.next()) & ((1u << ((size + 1) * (size + 1))) - 1);
+            rows.emplace_back(pattern(bits, size) + " => " + pattern(output, size + 1));
+        }
+    }
+    return lines(rows);
+}
+
+// an n by n grid (odd, so it has a middle), about half of it infected.
+inline std::string day22(size_t n, Rng& rng) {
+    const size_t side = std::max<size_t>(n, 1) | 1;
+    std::vector<std::string> rows(side, std::string(side, '.'));
+    for (auto& r : rows) {
+        for (auto& c : r) c = rng.chance(0.5) ? '#' : '.';
+    }
+    return lines(rows);
+}
+
+// the puzzle's own program, counting the composite numbers in a range. Part 1 runs it as is, with b = n, which takes about
+// n squared multiplications. The solver's part 2 reads its constants from these lines.
+inline std::string day23(size_t n, Rng&) {
+    return lines({
+        "set b " + number(std::max(3, asInt(n, "b"))), "set c b", "jnz a 2", "jnz 1 5", "mul b 100", "sub b -100000", "set c b", "sub c -17000",
+        "set f 1", "set d 2", "set e 2", "set g d", "mul g e", "sub g b", "jnz g 2", "set f 0", "sub e -1", "set g e", "sub g b", "jnz g -8",
+        "sub d -1", "set g d", "sub g b", "jnz g -13", "jnz f 2", "sub h -1", "set g b", "sub g c", "jnz g 2", "jnz 1 3", "sub b -17", "jnz 1 -23",
+    });
+}
+
+// n distinct components with ports up to 50, one of them able to start a bridge. The solver keeps the used components in a
+// 64 bit mask.
+inline std::string day24(size_t n, Rng& rng) {
+    if (n > 64) throw std::invalid_argument("day 24 takes at most 64 components");
+    const size_t count = std::max<size_t>(n, 1);
+
+    std::set<std::pair<int64_t, int64_t>> components;
+    while (components.size() + 1 < count) {
+        int64_t a = rng.between(1, 50), b = rng.between(1, 50);
+        components.emplace(std::min(a, b), std::max(a, b));
+    }
+    // the start fits onto one of the others.
+    components.emplace(0, components.empty() ? rng.between(1, 50) : std::next(components.begin(), rng.between(0, std::ssize(components) - 1))->second);
+    std::vector<std::pair<int64_t, int64_t>> shuffled(components.begin(), components.end());
+    rng.shuffle(shuffled);
+    return join(shuffled, "\n", [&](const std::pair<int64_t, int64_t>& c) {
+        return rng.chance(0.5) ? number(c.first) + "/" + number(c.second) : number(c.second) + "/" + number(c.first);
+    });
+}
+
+// a six state turing machine with random rules, to run for n steps. On a blank cell, even states move right and odd states
+// left, and hand over to a state of the other kind, so the head keeps coming back over what it wrote instead of running off.
+inline std::string day25(size_t n, Rng& rng) {
+    constexpr int states = 6;
+    std::string text = "Begin in state A.\nPerform a diagnostic checksum after " + number(std::max(1, asInt(n, "the step count"))) + " steps.\n";
+    for (int s = 0; s < states; ++s) {
+        text += std::string("\nIn state ") + static_cast<char>('A' + s) + ":\n";
+        for (int value = 0; value < 2; ++value) {
+            const bool left = value == 0 ? s % 2 == 1 : rng.chance(0.5);
+            const auto next = value == 0 ? 2 * rng.between(0, states / 2 - 1) + (s + 1) % 2 : rng.between(0, states - 1);
+            text += "  If the current value is " + number(value) + ":\n";
+            text += "    - Write the value " + number(value == 0 ? 1 : rng.between(0, 1)) + ".\n";
+            text += std::string("    - Move one slot to the ") + (left ? "left" : "right") + ".\n";
+            text += std::string("    - Continue with state ") + static_cast<char>('A' + next) + ".";
+            if (s + 1 < states || value == 0) text += "\n";
+        }
+    }
+    return text;
+}
+
+using Generator = std::string (*)(size_t scale, Rng& rng);
+
+struct Entry {
+    Generator make;
+    const char* unit; // what the scale counts, or nullptr if the input has a fixed size.
+    size_t puzzle; // the scale of the checked-in input, roughly.
+};
+
+inline const std::map<int, Entry>& table() {
+    static const std::map<int, Entry> entries {
+        { 1,  { day1,  "digits", 2'000 } },
+        { 2,  { day2,  "rows", 16 } },
+        { 3,  { day3,  "the square number", 289'326 } },
+        { 4,  { day4,  "passphrases", 512 } },
+        { 5,  { day5,  "jump offsets", 1'065 } },
+        { 6,  { day6,  nullptr, 0 } },
+        { 7,  { day7,  "programs", 1'000 } },
+        { 8,  { day8,  "instructions", 1'000 } },
+        { 9,  { day9,  "characters", 15'000 } },
+        { 10, { day10, "lengths", 16 } },
+        { 11, { day11, "steps", 8'000 } },
+        { 12, { day12, "programs", 2'000 } },
+        { 13, { day13, "layers", 43 } },
+        { 14, { day14, "key characters", 8 } },
+        { 15, { day15, nullptr, 0 } },
+        { 16, { day16, "dance moves", 10'000 } },
+        { 17, { day17, nullptr, 0 } },
+        { 18, { day18, "numbers to sort", 127 } },
+        { 19, { day19, "path corners", 8'000 } },
+        { 20, { day20, "particles", 1'000 } },
+        { 21, { day21, nullptr, 0 } },
+        { 22, { day22, "grid side", 25 } },
+        { 23, { day23, "the b register", 99 } },
+        { 24, { day24, "components (at most 64)", 57 } },
+        { 25, { day25, "steps", 12'000'000 } },
+    };
+    return entries;
+}
+
+// nullptr when the day's input does not grow with the scale.
+inline const char* unit(int day) {
+    auto iter = table().find(day);
+    if (iter == table().end()) throw std::invalid_argument("no generator for day " + std::to_string(day));
+    return iter->second.unit;
+}
+
+// the scale of the day's own input, for picking sizes around it.
+inline size_t puzzle(int day) {
+    auto iter = table().find(day);
+    if (iter == table().end()) throw std::invalid_argument("no generator for day " + std::to_string(day));
+    return iter->second.puzzle;
+}
+
+inline std::string generate(int day, size_t scale, uint64_t seed) {
+    auto iter = table().find(day);
+    if (iter == table().end()) throw std::invalid_argument("no generator for day " + std::to_string(day));
+    if (scale == 0 && iter->second.unit != nullptr) throw std::invalid_argument("scale must be positive");
+
+    Rng rng(seed);
+    return iter->second.make(scale, rng);
+}
+
+} // namespace Generate
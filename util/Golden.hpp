@@ -0,0 +1,45 @@
+#pragma once
+
+#include <fstream>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "Scan.hpp"
+
+/**
+ * Known good answers, to check the benchmarked ones against.
+ *
+ * The file has one "Day <n> v<part>: <answer>" line per answer, which is exactly what solve_all prints, so a golden file is
+ * made with `main <root> solve_all > golden.txt` on a build that is known to be right. Other lines are ignored.
+ */
+class Golden {
+public:
+    explicit Golden(const std::string& path) {
+        std::ifstream f(path);
+        if (! f) throw std::invalid_argument("could not read: " + path);
+
+        std::string line;
+        while (std::getline(f, line)) {
+            if (! line.starts_with("Day ")) continue;
+            Scanner scan(line);
+            scan.expect("Day ");
+            int day = scan.integer();
+            if (! scan.skip(" v")) continue;
+            int part = scan.integer();
+            if (! scan.skip(": ")) continue;
+            answers[{ day, part }] = std::string(scan.rest());
+        }
+    }
+
+    [[nodiscard]] std::optional<std::string> expected(int day, int part) const {
+        auto iter = answers.find({ day, part });
+        if (iter == answers.end()) return std::nullopt;
+        return iter->second;
+    }
+
+private:
+    std::map<std::pair<int, int>, std::string> answers;
+};
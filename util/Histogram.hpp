@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <bit>
+
+/**
+ * Log-bucketed histogram of non-negative integers, in the style of HdrHistogram.
+ *
+ * Values below 2^SUB_BITS get a bucket each. Above that, every power of two is split into 2^(SUB_BITS-1) equal buckets,
+ * so a bucket is never wider than 1/128th of the values in it (with SUB_BITS = 8). That is the worst case relative error of
+ * a percentile read back from it. Memory is fixed (about 60 KB) no matter how many values are recorded.
+ */
+class LogHistogram {
+public:
+    static constexpr int SUB_BITS = 8;
+
+    LogHistogram() : counts(N_BUCKETS, 0) {}
+
+    void record(uint64_t value) {
+        ++counts[index(value)];
+        ++total;
+    }
+
+    void clear() {
+        std::fill(counts.begin(), counts.end(), 0);
+        total = 0;
+    }
+
+    [[nodiscard]] uint64_t size() const { return total; }
+
+    // value at or below which a fraction 'q' of all recorded values are. Assumes size() > 0 and 0 <= q <= 1.
+    [[nodiscard]] uint64_t quantile(double q) const {
+        // the same rank as indexing a sorted array with floor(n * q), so both backends of BenchmarkStats agree.
+        auto rank = static_cast<uint64_t>(static_cast<double>(total) * q);
+        if (rank >= total) rank = total - 1;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen > rank) return representative(i);
+        }
+        return representative(counts.size() - 1);
+    }
+
+private:
+    static constexpr uint64_t SUB_COUNT = uint64_t{1} << SUB_BITS;
+    static constexpr uint64_t HALF = SUB_COUNT / 2;
+    static constexpr size_t N_BUCKETS = SUB_COUNT + (64 - SUB_BITS) * HALF;
+
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+
+    static size_t index(uint64_t v) {
+        if (v < SUB_COUNT) return v;
+
+        int shift = std::bit_width(v) - SUB_BITS; // >= 1. Leaves v >> shift in [HALF, SUB_COUNT).
+        return SUB_COUNT + (shift - 1) * HALF + ((v >> shift) - HALF);
+    }
+
+    // middle of the range of values that land in bucket 'i'.
+    static uint64_t representative(size_t i) {
+        if (i < SUB_COUNT) return i;
+
+        auto k = i - SUB_COUNT;
+        int shift = static_cast<int>(k / HALF) + 1;
+        uint64_t mantissa = k % HALF + HALF;
+        uint64_t low = mantissa << shift;
+        return low + ((uint64_t{1} << shift) - 1) / 2;
+    }
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * A whole input file, mapped into memory read-only. view() is valid as long as the MappedFile lives.
+ *
+ * Falls back to reading the file into a std::string if it cannot be mapped (empty files cannot be, and some filesystems refuse).
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::filesystem::path& path) : origin(path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::invalid_argument(" could not read: " + path.string());
+        }
+
+        struct stat info {};
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* p = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                mapped = static_cast<const char*>(p);
+                mapped_size = static_cast<size_t>(info.st_size);
+                // advice values are not flags, so one call each.
+                madvise(p, mapped_size, MADV_SEQUENTIAL);
+                madvise(p, mapped_size, MADV_WILLNEED);
+            }
+        }
+        ::close(fd);
+
+        if (! mapped) {
+            std::ifstream f(path, std::ios::binary);
+            if (! f) throw std::invalid_argument(" could not read: " + path.string());
+            std::ostringstream ss;
+            ss << f.rdbuf();
+            fallback = std::move(ss).str();
+        }
+    }
+
+    // not a file at all: 'bytes' held in memory, e.g. an input that arrived over a socket.
+    static MappedFile fromBytes(std::string bytes) {
+        MappedFile m;
+        m.fallback = std::move(bytes);
+        return m;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            mapped = std::exchange(other.mapped, nullptr);
+            mapped_size = std::exchange(other.mapped_size, 0);
+            fallback = std::move(other.fallback);
+            origin = std::move(other.origin);
+        }
+        return *this;
+    }
+
+    ~MappedFile() { unmap(); }
+
+    [[nodiscard]] std::string_view view() const {
+        return mapped ? std::string_view(mapped, mapped_size) : std::string_view(fallback);
+    }
+
+    // where the bytes came from. Empty for fromBytes().
+    [[nodiscard]] const std::filesystem::path& path() const { return origin; }
+
+private:
+    const char* mapped = nullptr;
+    size_t mapped_size = 0;
+    std::string fallback;
+    std::filesystem::path origin;
+
+    void unmap() {
+        if (mapped) munmap(const_cast<char*>(mapped), mapped_size);
+        mapped = nullptr;
+        mapped_size = 0;
+    }
+};
+
+/**
+ * Read cursor over an in-memory input, handed to Day::parse.
+ *
+ * getline() behaves like std::getline: lines are split on '\n' (which is dropped), a last line without one still counts,
+ * and it returns false once everything is consumed. The string_view overload does not copy; its lines point into the input.
+ * rewind() starts over, which is all the parse benchmark needs to reset between samples.
+ */
+class Input {
+public:
+    Input() = default;
+    explicit Input(std::string_view data) : data(data) {}
+
+    bool getline(std::string_view& line) {
+        if (pos >= data.size()) return false;
+
+        auto end = data.find('\n', pos);
+        if (end == std::string_view::npos) end = data.size();
+        line = data.substr(pos, end - pos);
+        pos = end + 1;
+        return true;
+    }
+
+    bool getline(std::string& line) {
+        std::string_view view;
+        if (! getline(view)) return false;
+        line.assign(view);
+        return true;
+    }
+
+    // every line that has not been read yet.
+    std::vector<std::string_view> lines() {
+        std::vector<std::string_view> result;
+        std::string_view line;
+        while (getline(line)) result.push_back(line);
+        return result;
+    }
+
+    // everything, regardless of what has been read already.
+    [[nodiscard]] std::string_view text() const { return data; }
+
+    // what has not been read yet.
+    [[nodiscard]] std::string_view rest() const { return pos < data.size() ? data.substr(pos) : std::string_view{}; }
+
+    void rewind() { pos = 0; }
+
+private:
+    std::string_view data;
+    size_t pos = 0;
+};
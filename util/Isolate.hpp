@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <functional>
+#include <mutex>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Affinity.hpp"
+#include "Day.hpp"
+#include "Report.hpp"
+
+/**
+ * Benchmarking in a child process, so whatever the work leaves behind (heap fragmentation, peak RSS, warm allocator caches)
+ * is gone when it is done, and does not affect what is measured next. Numbers then do not depend on which days ran before.
+ *
+ * FORK children start as a copy of the parent. EXEC children are a fresh start of this program in worker mode,
+ * with nothing inherited but the arguments, for when even the parent's own heap layout should not matter.
+ * Either way the child sends its stats back over a pipe as Report JSON, and the parent turns them back into BenchmarkStats.
+ * That keeps the timings and memory, but see Report::restore for what does not survive the trip.
+ */
+namespace Isolate {
+
+    enum class Mode {
+        NONE,
+        FORK,
+        EXEC,
+    };
+
+    inline Mode parseMode(const std::string& name) {
+        if (name == "none") return Mode::NONE;
+        if (name == "fork") return Mode::FORK;
+        if (name == "exec") return Mode::EXEC;
+        throw std::invalid_argument("unknown isolation mode: " + name);
+    }
+
+    // writes the phases of 'stats' that were measured to 'fd' as Report JSON, for receive() on the other end.
+    inline bool send(int fd, int day, const Day::StatTriplet& stats) {
+        static const char* phases[] = { "parse", "v1", "v2" };
+        std::vector<Report::Entry> entries;
+        for (int i = 0; i < 3; ++i) {
+            if (stats[i].n_samples() > 0) entries.push_back({ day, phases[i], &stats[i] });
+        }
+        std::ostringstream json;
+        Report::writeJson(json, entries);
+
+        auto text = json.str();
+        for (size_t written = 0; written < text.size();) {
+            ssize_t n = write(fd, text.data() + written, text.size() - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            written += n;
+        }
+        return true;
+    }
+
+    // the phases in 'text' replace their counterparts in 'into'. Others are left alone, so per phase workers can fill one each.
+    inline void receive(const std::string& text, Day::StatTriplet& into) {
+        static const std::string phases[] = { "parse", "v1", "v2" };
+        auto json = Json::parse(text);
+        for (auto& r : json["results"].array()) {
+            auto phase = std::ranges::find(phases, r["phase"].string()) - std::begin(phases);
+            if (phase == 3) throw std::runtime_error("isolate: worker sent unknown phase " + r["phase"].string());
+            into[phase] = Report::restore(r);
+        }
+    }
+
+    // bench_all --jobs N starts children from several threads at once. A child must not inherit the write end of another
+    // child's pipe, or that pipe only sees EOF once this (unrelated, maybe long-running) child exits too. So pipe, fork and
+    // closing the parent's write end happen under one lock: while it is not held, no write end is open in the parent. The
+    // pipes are also close-on-exec, and a forked child closes the read ends of its siblings, which it has no use for either.
+    namespace detail {
+        inline std::mutex spawning;
+        inline std::vector<int> readEnds; // of the pipes of running children. Guarded by 'spawning'.
+    }
+
+    /**
+     * Runs 'inChild' in a fork of this process, pinned to 'cpu' unless that is negative, and returns what it wrote to the
+     * pipe it was given. Its return value is the child's exit status. Throws std::runtime_error if the child fails.
+     */
+    inline std::string child(const std::function<int(int fd)>& inChild, int cpu) {
+        int fds[2];
+        std::unique_lock lock(detail::spawning);
+        if (pipe2(fds, O_CLOEXEC) != 0) throw std::runtime_error("isolate: pipe2() failed");
+
+        std::cout.flush(); // or the child inherits, and prints again, whatever is still buffered.
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            throw std::runtime_error("isolate: fork() failed");
+        }
+
+        if (pid == 0) {
+            // the lock is held by the thread that forked, so the list is stable. The child never takes the lock itself.
+            for (int fd : detail::readEnds) close(fd);
+            close(fds[0]);
+            if (cpu >= 0) Affinity::pinCurrentThread(cpu); // also holds after an exec.
+            int status;
+            try {
+                status = inChild(fds[1]);
+            } catch (const std::exception& e) {
+                std::cerr << "isolate: " << e.what() << "\n";
+                status = 1;
+            }
+            std::cout.flush();
+            _exit(status); // not exit(): the parent's atexit handlers and static destructors are not ours to run.
+        }
+
+        close(fds[1]);
+        detail::readEnds.push_back(fds[0]);
+        lock.unlock();
+
+        std::string text;
+        char buffer[1 << 16];
+        for (ssize_t n; (n = read(fds[0], buffer, sizeof(buffer))) != 0;) {
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            text.append(buffer, n);
+        }
+        lock.lock();
+        std::erase(detail::readEnds, fds[0]);
+        close(fds[0]);
+        lock.unlock();
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (! WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            throw std::runtime_error("isolate: worker " + std::to_string(pid) + " failed");
+        }
+        return text;
+    }
+
+    // runs 'work' in a fork of this process, and copies the phases it measured into 'into'.
+    inline void forked(int day, const std::function<void(Day::StatTriplet&)>& work, int cpu, Day::StatTriplet& into) {
+        auto text = child([&](int fd) {
+            Day::StatTriplet stats;
+            work(stats);
+            return send(fd, day, stats) ? 0 : 2;
+        }, cpu);
+        receive(text, into);
+    }
+
+    /**
+     * Runs this program again as 'arguments' (without argv[0]), with "--result-fd N" appended, and copies the phases it
+     * measured into 'into'. The worker is expected to send() its stats to that fd, see main().
+     */
+    inline void executed(const std::vector<std::string>& arguments, int cpu, Day::StatTriplet& into) {
+        auto text = child([&](int fd) {
+            std::vector<std::string> all { "/proc/self/exe" };
+            all.insert(all.end(), arguments.begin(), arguments.end());
+            all.emplace_back("--result-fd");
+            all.push_back(std::to_string(fd));
+            fcntl(fd, F_SETFD, 0); // the one pipe the worker is meant to keep across the exec.
+
+            std::vector<char*> argv;
+            for (auto& a : all) argv.push_back(a.data());
+            argv.push_back(nullptr);
+            execv(argv[0], argv.data());
+            std::cerr << "isolate: could not exec " << argv[0] << "\n";
+            return 127;
+        }, cpu);
+        receive(text, into);
+    }
+}
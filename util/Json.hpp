@@ -0,0 +1,188 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <variant>
+#include <sstream>
+#include <stdexcept>
+#include <cctype>
+#include <cstdlib>
+
+/**
+ * Just enough JSON to read back what Report writes: objects, arrays, strings (with the common escapes), numbers, bools and null.
+ * Not a validator, and \u escapes outside ASCII are not decoded. Throws std::invalid_argument on anything it cannot make sense of.
+ */
+namespace Json {
+
+    struct Value;
+    using Object = std::map<std::string, Value>;
+    using Array = std::vector<Value>;
+
+    struct Value {
+        std::variant<std::nullptr_t, bool, double, std::string, Array, Object> v = nullptr;
+
+        [[nodiscard]] const Object& object() const { return std::get<Object>(v); }
+        [[nodiscard]] const Array& array() const { return std::get<Array>(v); }
+        [[nodiscard]] const std::string& string() const { return std::get<std::string>(v); }
+        [[nodiscard]] double number() const { return std::get<double>(v); }
+        [[nodiscard]] bool boolean() const { return std::get<bool>(v); }
+
+        [[nodiscard]] bool has(const std::string& key) const {
+            return std::holds_alternative<Object>(v) && object().contains(key);
+        }
+
+        [[nodiscard]] const Value& operator[](const std::string& key) const {
+            auto& o = object();
+            auto iter = o.find(key);
+            if (iter == o.end()) throw std::invalid_argument("json: no key '" + key + "'");
+            return iter->second;
+        }
+    };
+
+    // escapes 's' for use between double quotes. Control characters always are, so any input bytes make valid JSON.
+    inline std::string quote(const std::string& s) {
+        std::string out = "\"";
+        for (char c : s) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                case '\r': out += "\\r"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        static constexpr char hex[] = "0123456789abcdef";
+                        out += "\\u00";
+                        out += hex[(c >> 4) & 0xf];
+                        out += hex[c & 0xf];
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+        return out + "\"";
+    }
+
+    class Parser {
+    public:
+        explicit Parser(const std::string& text) : s(text) {}
+
+        Value parse() {
+            Value v = value();
+            skip();
+            if (i != s.size()) fail("trailing characters");
+            return v;
+        }
+
+    private:
+        const std::string& s;
+        size_t i = 0;
+
+        [[noreturn]] void fail(const std::string& why) const {
+            throw std::invalid_argument("json: " + why + " at offset " + std::to_string(i));
+        }
+
+        void skip() {
+            while (i < s.size() && std::isspace(static_cast<unsigned char>(s[i]))) ++i;
+        }
+
+        void expect(char c) {
+            skip();
+            if (i >= s.size() || s[i] != c) fail(std::string("expected '") + c + "'");
+            ++i;
+        }
+
+        bool literal(const char* word) {
+            size_t n = std::char_traits<char>::length(word);
+            if (s.compare(i, n, word) != 0) return false;
+            i += n;
+            return true;
+        }
+
+        Value value() {
+            skip();
+            if (i >= s.size()) fail("unexpected end");
+
+            char c = s[i];
+            if (c == '{') return { object() };
+            if (c == '[') return { array() };
+            if (c == '"') return { string() };
+            if (literal("true")) return { true };
+            if (literal("false")) return { false };
+            if (literal("null")) return { nullptr };
+            return { number() };
+        }
+
+        Object object() {
+            Object o;
+            expect('{');
+            skip();
+            if (s[i] == '}') { ++i; return o; }
+            while (true) {
+                skip();
+                std::string key = string();
+                expect(':');
+                o.emplace(std::move(key), value());
+                skip();
+                if (s[i] == ',') { ++i; continue; }
+                expect('}');
+                return o;
+            }
+        }
+
+        Array array() {
+            Array a;
+            expect('[');
+            skip();
+            if (s[i] == ']') { ++i; return a; }
+            while (true) {
+                a.push_back(value());
+                skip();
+                if (s[i] == ',') { ++i; continue; }
+                expect(']');
+                return a;
+            }
+        }
+
+        std::string string() {
+            if (s[i] != '"') fail("expected string");
+            ++i;
+            std::string out;
+            while (i < s.size() && s[i] != '"') {
+                char c = s[i++];
+                if (c != '\\') { out += c; continue; }
+                if (i >= s.size()) break;
+                char e = s[i++];
+                switch (e) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u': out += static_cast<char>(std::strtol(s.substr(i, 4).c_str(), nullptr, 16)); i += 4; break;
+                    default: out += e; // \" \\ \/
+                }
+            }
+            if (i >= s.size()) fail("unterminated string");
+            ++i;
+            return out;
+        }
+
+        double number() {
+            const char* begin = s.c_str() + i;
+            char* end = nullptr;
+            double d = std::strtod(begin, &end);
+            if (end == begin) fail("expected a value");
+            i += end - begin;
+            return d;
+        }
+    };
+
+    inline Value parse(const std::string& text) {
+        return Parser(text).parse();
+    }
+}
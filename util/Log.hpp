@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+
+/**
+ * Diagnostic output for the solvers, gated twice:
+ *
+ * At compile time by AOC_LOG_LEVEL (set through CMake). Log statements above it are discarded by 'if constexpr',
+ * so their arguments are never evaluated and a disabled LOG_TRACE in a hot loop costs exactly nothing.
+ * At run time by Log::setLevel(), so a build with tracing compiled in can still be quiet. main() turns it off for benchmarks.
+ *
+ * Usage, streaming style: LOG_DEBUG("hdist " << h_dist);
+ */
+namespace Log {
+
+    enum class Level {
+        OFF = 0,
+        ERROR = 1,
+        INFO = 2,
+        DEBUG = 3,
+        TRACE = 4,
+    };
+
+    inline std::atomic<Level> current { Level::INFO };
+
+    inline void setLevel(Level l) { current.store(l, std::memory_order_relaxed); }
+
+    inline bool enabled(Level l) {
+        return static_cast<int>(l) <= static_cast<int>(current.load(std::memory_order_relaxed));
+    }
+
+    inline Level parseLevel(const std::string& name) {
+        if (name == "off") return Level::OFF;
+        if (name == "error") return Level::ERROR;
+        if (name == "info") return Level::INFO;
+        if (name == "debug") return Level::DEBUG;
+        if (name == "trace") return Level::TRACE;
+        throw std::invalid_argument("unknown log level: " + name);
+    }
+}
+
+#ifndef AOC_LOG_LEVEL
+#define AOC_LOG_LEVEL 2 // INFO
+#endif
+
+#define AOC_LOG(LEVEL, ...) \
+    do { \
+        if constexpr (static_cast<int>(LEVEL) <= AOC_LOG_LEVEL) { \
+            if (Log::enabled(LEVEL)) { std::cout << __VA_ARGS__ << "\n"; } \
+        } \
+    } while (false)
+
+#define LOG_ERROR(...) AOC_LOG(Log::Level::ERROR, __VA_ARGS__)
+#define LOG_INFO(...) AOC_LOG(Log::Level::INFO, __VA_ARGS__)
+#define LOG_DEBUG(...) AOC_LOG(Log::Level::DEBUG, __VA_ARGS__)
+#define LOG_TRACE(...) AOC_LOG(Log::Level::TRACE, __VA_ARGS__)
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+
+#include <sys/resource.h>
+
+/**
+ * Resident memory and page faults, for reporting what a phase costs in memory next to what it costs in time.
+ *
+ * Page faults come from getrusage(RUSAGE_THREAD), so phases benchmarked concurrently on other threads do not count.
+ * Peak RSS is per process (VmHWM in /proc/self/status). Linux lets us reset it through /proc/self/clear_refs,
+ * which makes it a per phase high-water mark, but only while nothing else runs in the process. Otherwise it is the
+ * process lifetime peak, and the only way to separate days is to give each its own process (bench_all --fork).
+ */
+namespace Memory {
+
+    struct Faults {
+        long minor = 0; // served without I/O, e.g. first touch of a freshly allocated page.
+        long major = 0; // needed I/O, e.g. reading the mapped input back in.
+    };
+
+    struct Usage {
+        long peak_rss_kb = 0;
+        bool peak_is_phase = false; // false: the peak is over the whole process so far.
+        Faults faults;
+    };
+
+    inline Faults faults() {
+        rusage r {};
+#ifdef RUSAGE_THREAD
+        getrusage(RUSAGE_THREAD, &r);
+#else
+        getrusage(RUSAGE_SELF, &r);
+#endif
+        return { r.ru_minflt, r.ru_majflt };
+    }
+
+    // a "Key:   1234 kB" line of /proc/self/status, 0 if there is no such line.
+    inline long statusKb(const std::string& key) {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.starts_with(key) && line.size() > key.size() && line[key.size()] == ':') {
+                return std::stol(line.substr(key.size() + 1));
+            }
+        }
+        return 0;
+    }
+
+    inline long peakRssKb() {
+        if (long hwm = statusKb("VmHWM")) return hwm;
+        rusage r {};
+        getrusage(RUSAGE_SELF, &r);
+        return r.ru_maxrss; // kB on Linux.
+    }
+
+    // makes the peak RSS start over from the current RSS. False if the kernel does not support it (before 4.0, or not Linux).
+    inline bool resetPeak() {
+        std::ofstream clear("/proc/self/clear_refs");
+        clear << "5";
+        clear.flush();
+        return clear.good();
+    }
+
+    // what happened since 'before' was taken, and resetPeak() returned 'peakWasReset'.
+    inline Usage since(const Faults& before, bool peakWasReset) {
+        auto now = faults();
+        return { peakRssKb(), peakWasReset, { now.minor - before.minor, now.major - before.major } };
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <omp.h>
+
+/**
+ * How well a phase uses more OpenMP threads.
+ *
+ * speedup S(p) = T(1) / T(p), efficiency S(p) / p. The Karp-Flatt metric e = (1/S - 1/p) / (1 - 1/p) is the serial fraction
+ * that Amdahl's law would need to explain the measured speedup. If it stays flat as p grows, the code has that much serial
+ * work; if it grows, the parallel part itself stops scaling (synchronisation, memory bandwidth, load imbalance).
+ */
+namespace Parallel {
+
+    struct Efficiency {
+        double speedup;
+        double efficiency;
+        double serialFraction; // NaN for p = 1, where it is undefined.
+    };
+
+    inline Efficiency of(double t1, double tp, int p) {
+        const double speedup = tp > 0 ? t1 / tp : NAN;
+        const double serial = p > 1 ? (1 / speedup - 1.0 / p) / (1 - 1.0 / p) : NAN;
+        return { speedup, speedup / p, serial };
+    }
+
+    // 1, 2, 4, ... and 'max' itself if it is not a power of two.
+    inline std::vector<int> threadCounts(int max) {
+        std::vector<int> counts;
+        for (int p = 1; p < max; p *= 2) counts.push_back(p);
+        counts.push_back(std::max(max, 1));
+        return counts;
+    }
+
+    inline int cores() { return omp_get_num_procs(); }
+
+    // for parallel regions started from this thread from now on, like OMP_NUM_THREADS.
+    inline void setThreads(int p) { omp_set_num_threads(p); }
+
+    inline int threads() { return omp_get_max_threads(); }
+
+} // namespace Parallel
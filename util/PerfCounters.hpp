@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * Hardware (and a few software) event counters for the calling thread, through perf_event_open.
+ *
+ * Every event gets its own file descriptor, so one the CPU or kernel refuses (VMs often have no cache events,
+ * perf_event_paranoid may forbid all of them) does not take the others down with it. Check has() per event, or
+ * available() for "anything at all". Counters run from construction until destruction; take read() before and after
+ * the code of interest and subtract with delta().
+ *
+ * Six events are more than most PMUs count at once, so the kernel multiplexes them: each is only counting for part of the
+ * time it is enabled. Every read therefore also takes the enabled and running times, and delta() scales each count up by
+ * enabled / running over the interval. An event that did not run at all in the interval has no estimate and is marked so.
+ */
+class PerfCounters {
+public:
+    enum Event {
+        CYCLES,
+        INSTRUCTIONS,
+        BRANCH_MISSES,
+        L1D_MISSES,
+        LLC_MISSES,
+        PAGE_FAULTS,
+        N_EVENTS,
+    };
+
+    struct Reading {
+        std::array<uint64_t, N_EVENTS> value {};
+        std::array<uint64_t, N_EVENTS> enabled {}; // ns
+        std::array<uint64_t, N_EVENTS> running {}; // ns
+    };
+
+    // the counts between two readings, scaled for multiplexing.
+    struct Delta {
+        std::array<uint64_t, N_EVENTS> count {};
+        std::array<bool, N_EVENTS> measured {}; // false if the event was never scheduled in between, its count is then 0 and meaningless.
+    };
+
+    PerfCounters() {
+        fds.fill(-1);
+        open(CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open(INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open(BRANCH_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        open(L1D_MISSES, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        open(LLC_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        open(PAGE_FAULTS, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    [[nodiscard]] bool has(Event e) const { return fds[e] >= 0; }
+
+    [[nodiscard]] bool available() const {
+        for (int fd : fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    // events that are not available read as 0.
+    [[nodiscard]] Reading read() const {
+        Reading r {};
+        for (int e = 0; e < N_EVENTS; ++e) {
+            if (fds[e] < 0) continue;
+            uint64_t values[3] {}; // value, time enabled, time running: the read_format set in open().
+            if (::read(fds[e], values, sizeof(values)) == sizeof(values)) {
+                r.value[e] = values[0];
+                r.enabled[e] = values[1];
+                r.running[e] = values[2];
+            }
+        }
+        return r;
+    }
+
+    static Delta delta(const Reading& before, const Reading& after) {
+        Delta d {};
+        for (int e = 0; e < N_EVENTS; ++e) {
+            const uint64_t value = after.value[e] - before.value[e];
+            const uint64_t enabled = after.enabled[e] - before.enabled[e];
+            const uint64_t running = after.running[e] - before.running[e];
+            d.measured[e] = running > 0;
+            if (! d.measured[e]) continue;
+            d.count[e] = running >= enabled ? value : static_cast<uint64_t>(static_cast<double>(value) * static_cast<double>(enabled) / static_cast<double>(running) + 0.5);
+        }
+        return d;
+    }
+
+    static const char* name(Event e) {
+        static constexpr const char* names[N_EVENTS] = { "cycles", "instructions", "branch misses", "L1d misses", "LLC misses", "page faults" };
+        return names[e];
+    }
+
+private:
+    std::array<int, N_EVENTS> fds {};
+
+    void open(Event e, uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        // only count what the benchmarked code does, not the kernel on its behalf. Page faults happen in the kernel by definition.
+        attr.exclude_kernel = type == PERF_TYPE_SOFTWARE ? 0 : 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // pid 0, cpu -1: this thread, on whichever CPU it runs. No group leader.
+        fds[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+};
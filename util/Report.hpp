@@ -0,0 +1,259 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <ctime>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+
+#include <unistd.h>
+
+#include "BenchStats.hpp"
+#include "Bootstrap.hpp"
+#include "Json.hpp"
+#include "Result.hpp"
+
+#ifndef GIT_REVISION
+#define GIT_REVISION "unknown" // set by CMake at configure time.
+#endif
+
+/**
+ * Machine readable benchmark results, and comparing them against a stored baseline.
+ *
+ * JSON keeps every sample (when the stats kept them), so a later run can be tested against it with compare().
+ * CSV has the summary only, one row per day and phase, for spreadsheets and plotting.
+ * All times are in nanoseconds, memory in kB.
+ */
+namespace Report {
+
+    struct Entry {
+        int day;
+        std::string phase; // "parse", "v1" or "v2".
+        const BenchmarkStats* stats;
+    };
+
+    struct Metadata {
+        std::string host;
+        std::string compiler;
+        std::string revision;
+        std::string timestamp; // UTC, ISO 8601.
+        unsigned threads;
+    };
+
+    inline Metadata metadata() {
+        char host[256] = {};
+        gethostname(host, sizeof(host) - 1);
+
+        char when[32] = {};
+        std::time_t now = std::time(nullptr);
+        std::strftime(when, sizeof(when), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#if defined(__clang__)
+        std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+        std::string compiler = "gcc " __VERSION__;
+#else
+        std::string compiler = "unknown";
+#endif
+        return { host, compiler, GIT_REVISION, when, std::thread::hardware_concurrency() };
+    }
+
+    inline void writeJson(std::ostream& o, const std::vector<Entry>& entries) {
+        auto m = metadata();
+        o << "{\n";
+        o << "  \"meta\": { \"host\": " << Json::quote(m.host) << ", \"compiler\": " << Json::quote(m.compiler)
+          << ", \"revision\": " << Json::quote(m.revision) << ", \"timestamp\": " << Json::quote(m.timestamp)
+          << ", \"threads\": " << m.threads << " },\n";
+        o << "  \"results\": [";
+        bool first = true;
+        for (auto& [day, phase, s] : entries) {
+            o << (first ? "\n" : ",\n");
+            first = false;
+            o << "    { \"day\": " << day << ", \"phase\": " << Json::quote(phase)
+              << ", \"n\": " << s->n_samples() << ", \"calls_per_sample\": " << s->n_calls_per_sample()
+              << ", \"stop\": " << Json::quote(s->stop_description()) << ", \"warmup\": " << s->n_warmups();
+            if (s->has_memory()) {
+                auto& m = s->memory();
+                o << ", \"peak_rss_kb\": " << m.peak_rss_kb << ", \"peak_rss_phase\": " << (m.peak_is_phase ? "true" : "false")
+                  << ", \"minor_faults\": " << m.faults.minor << ", \"major_faults\": " << m.faults.major;
+            }
+            if (s->has_verification()) {
+                o << ", \"verified\": " << s->answers_verified() << ", \"wrong_answers\": " << s->wrong_answers();
+                if (s->wrong_answers() > 0) o << ", \"wrong_answer\": " << Json::quote(s->first_wrong_answer());
+            }
+            if (s->n_samples() > 0) {
+                o << ", \"mean\": " << s->mean().count() << ", \"median\": " << s->median().count()
+                  << ", \"std_dev\": " << s->std_dev().count() << ", \"min\": " << s->lowest().count() << ", \"max\": " << s->highest().count()
+                  << ", \"p5\": " << s->nth_ile(0.05).count() << ", \"p95\": " << s->nth_ile(0.95).count() << ", \"p99\": " << s->nth_ile(0.99).count();
+            }
+            o << ", \"samples\": [";
+            for (size_t i = 0; i < s->samples().size(); ++i) {
+                o << (i ? "," : "") << s->samples()[i].count();
+            }
+            o << "] }";
+        }
+        o << "\n  ]\n}\n";
+    }
+
+    inline void writeCsv(std::ostream& o, const std::vector<Entry>& entries) {
+        auto m = metadata();
+        o << "day,phase,n,calls_per_sample,mean,median,std_dev,min,max,p5,p95,p99,peak_rss_kb,minor_faults,major_faults,host,compiler,revision,timestamp\n";
+        for (auto& [day, phase, s] : entries) {
+            o << day << "," << phase << "," << s->n_samples() << "," << s->n_calls_per_sample();
+            if (s->n_samples() > 0) {
+                o << "," << s->mean().count() << "," << s->median().count() << "," << s->std_dev().count()
+                  << "," << s->lowest().count() << "," << s->highest().count()
+                  << "," << s->nth_ile(0.05).count() << "," << s->nth_ile(0.95).count() << "," << s->nth_ile(0.99).count();
+            } else {
+                o << ",,,,,,,,";
+            }
+            if (s->has_memory()) {
+                o << "," << s->memory().peak_rss_kb << "," << s->memory().faults.minor << "," << s->memory().faults.major;
+            } else {
+                o << ",,,";
+            }
+            // the compiler string has spaces but no commas or quotes, so it does not need CSV quoting.
+            o << "," << m.host << "," << m.compiler << "," << m.revision << "," << m.timestamp << "\n";
+        }
+    }
+
+    // writes to 'jsonPath' / 'csvPath', if they are not empty.
+    inline void write(const std::vector<Entry>& entries, const std::string& jsonPath, const std::string& csvPath) {
+        if (! jsonPath.empty()) {
+            std::ofstream f(jsonPath);
+            if (! f) throw std::invalid_argument("could not write: " + jsonPath);
+            writeJson(f, entries);
+        }
+        if (! csvPath.empty()) {
+            std::ofstream f(csvPath);
+            if (! f) throw std::invalid_argument("could not write: " + csvPath);
+            writeCsv(f, entries);
+        }
+    }
+
+    /**
+     * One-sided Mann-Whitney U test: the p-value for "samples in 'after' tend to be larger than in 'before'".
+     * Normal approximation with tie correction, which is fine for the sample counts benchmarks produce (tens and up).
+     */
+    inline double mannWhitneyGreater(const std::vector<double>& before, const std::vector<double>& after) {
+        const size_t n1 = before.size(), n2 = after.size(), n = n1 + n2;
+
+        std::vector<std::pair<double, bool>> all; // (value, is from 'after')
+        all.reserve(n);
+        for (double x : before) all.emplace_back(x, false);
+        for (double x : after) all.emplace_back(x, true);
+        std::ranges::sort(all);
+
+        double rankSumAfter = 0;
+        double tieTerm = 0; // sum of t^3 - t over groups of t tied values.
+        for (size_t i = 0; i < n;) {
+            size_t j = i;
+            while (j < n && all[j].first == all[i].first) ++j;
+            double averageRank = (static_cast<double>(i + 1) + static_cast<double>(j)) / 2;
+            for (size_t k = i; k < j; ++k) {
+                if (all[k].second) rankSumAfter += averageRank;
+            }
+            auto t = static_cast<double>(j - i);
+            tieTerm += t * t * t - t;
+            i = j;
+        }
+
+        const auto N1 = static_cast<double>(n1), N2 = static_cast<double>(n2), N = static_cast<double>(n);
+        double u = rankSumAfter - N2 * (N2 + 1) / 2; // pairs where 'after' is the larger.
+        double mean = N1 * N2 / 2;
+        double variance = N1 * N2 / 12 * ((N + 1) - tieTerm / (N * (N - 1)));
+        if (variance <= 0) return 1.0; // everything tied.
+
+        double z = (u - mean) / std::sqrt(variance);
+        return 1 - Bootstrap::normal_cdf(z);
+    }
+
+    struct Comparison {
+        int day;
+        std::string phase;
+        double baselineMedian;
+        double currentMedian;
+        double pValue; // 1 if either side has too few samples to test.
+        bool regression;
+    };
+
+    /**
+     * Matches results by day and phase. A phase counts as regressed if its median got slower by more than 'minChange'
+     * (e.g. 0.02 for 2%) AND the Mann-Whitney test is significant at 'alpha'. Both, because with 10k samples a 0.1% difference
+     * is "significant" and nobody cares, and without the test every noisy phase would be flagged.
+     */
+    inline std::vector<Comparison> compare(const Json::Value& baseline, const Json::Value& current, double alpha, double minChange) {
+        auto samplesOf = [](const Json::Value& r) {
+            std::vector<double> v;
+            for (auto& x : r["samples"].array()) v.push_back(x.number());
+            return v;
+        };
+
+        std::vector<Comparison> result;
+        for (auto& now : current["results"].array()) {
+            auto day = static_cast<int>(now["day"].number());
+            auto& phase = now["phase"].string();
+
+            auto& before = baseline["results"].array();
+            auto match = std::ranges::find_if(before, [&](const Json::Value& r) {
+                return static_cast<int>(r["day"].number()) == day && r["phase"].string() == phase;
+            });
+            if (match == before.end() || ! match->has("median") || ! now.has("median")) continue;
+
+            Comparison c { day, phase, (*match)["median"].number(), now["median"].number(), 1.0, false };
+            auto a = samplesOf(*match), b = samplesOf(now);
+            if (a.size() >= 2 && b.size() >= 2) {
+                c.pValue = mannWhitneyGreater(a, b);
+            }
+            c.regression = c.pValue < alpha && c.currentMedian > c.baselineMedian * (1 + minChange);
+            result.push_back(std::move(c));
+        }
+        return result;
+    }
+
+    /**
+     * Rebuilds the stats of one entry of writeJson's "results", by replaying its samples. For getting stats out of another process.
+     * Only what the JSON has survives, answer checks included: no hardware counters or allocations, and nothing at all from STREAMING stats, which keep no samples.
+     */
+    inline BenchmarkStats restore(const Json::Value& r) {
+        BenchmarkStats s(r["phase"].string().starts_with("parse") ? Time { std::chrono::nanoseconds{1} } : Time { std::chrono::milliseconds{1} });
+        for (auto& x : r["samples"].array()) {
+            s.measurement(Time { static_cast<Time::rep>(x.number()) });
+        }
+        s.batched(static_cast<int>(r["calls_per_sample"].number()));
+
+        using Stop = BenchmarkStats::StopReason;
+        auto why = Stop::SAMPLE_COUNT;
+        for (auto reason : { Stop::BUDGET, Stop::CONVERGED }) {
+            if (BenchmarkStats::describe(reason) == r["stop"].string()) why = reason;
+        }
+        s.stopped(why, static_cast<int>(r["warmup"].number()));
+
+        if (r.has("peak_rss_kb")) {
+            s.memory({
+                static_cast<long>(r["peak_rss_kb"].number()), r["peak_rss_phase"].boolean(),
+                { static_cast<long>(r["minor_faults"].number()), static_cast<long>(r["major_faults"].number()) }
+            });
+        }
+
+        if (r.has("verified")) {
+            Result wrong;
+            if (r.has("wrong_answer")) wrong.set(r["wrong_answer"].string());
+            const auto checked = static_cast<uint64_t>(r["verified"].number());
+            const auto wrongs = static_cast<uint64_t>(r["wrong_answers"].number());
+            for (uint64_t i = 0; i < checked; ++i) s.verified(wrong, i >= wrongs);
+        }
+        return s;
+    }
+
+    inline Json::Value load(const std::string& path) {
+        std::ifstream f(path);
+        if (! f) throw std::invalid_argument("could not read: " + path);
+        std::stringstream ss;
+        ss << f.rdbuf();
+        return Json::parse(ss.str());
+    }
+}
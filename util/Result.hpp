@@ -0,0 +1,99 @@
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+/**
+ * One answer as a solver reported it: an integer, or text.
+ *
+ * Text up to 'inlineCapacity' characters is kept in the object itself, so reporting an answer does not allocate and the benchmarks
+ * can keep every call's answer without measuring the bookkeeping. Longer text spills to the heap. Turning an integer into text
+ * is left to whoever reads it, after the timing: str() for printing, matches() for checking against a known answer without
+ * allocating either.
+ */
+class Result {
+public:
+    static constexpr size_t inlineCapacity = 64;
+
+    enum class Kind : uint8_t {
+        NONE,
+        INTEGER,
+        TEXT,
+    };
+
+    void clear() { kind_ = Kind::NONE; }
+
+    void set(int64_t v) {
+        kind_ = Kind::INTEGER;
+        integer = v;
+    }
+
+    void set(std::string_view s) {
+        kind_ = Kind::TEXT;
+        length = s.size();
+        if (length <= inlineCapacity) {
+            std::memcpy(buffer, s.data(), length);
+        } else {
+            spilled.assign(s);
+        }
+    }
+
+    // anything else that can be streamed, e.g. a double. Allocates.
+    template<typename T>
+    void set(const T& v) {
+        if constexpr (std::integral<T>) {
+            set(static_cast<int64_t>(v));
+        } else if constexpr (std::convertible_to<const T&, std::string_view>) {
+            set(std::string_view(v));
+        } else {
+            std::ostringstream o;
+            o << v;
+            set(std::string_view(o.str()));
+        }
+    }
+
+    [[nodiscard]] Kind kind() const { return kind_; }
+    [[nodiscard]] bool empty() const { return kind_ == Kind::NONE; }
+
+    [[nodiscard]] std::string str() const {
+        switch (kind_) {
+            case Kind::INTEGER: return std::to_string(integer);
+            case Kind::TEXT: return std::string(text());
+            default: return {};
+        }
+    }
+
+    // same as str() == expected, ignoring trailing whitespace on both sides (some answers end in a newline).
+    [[nodiscard]] bool matches(std::string_view expected) const {
+        char digits[24];
+        std::string_view mine;
+        switch (kind_) {
+            case Kind::INTEGER: mine = { digits, static_cast<size_t>(std::to_chars(std::begin(digits), std::end(digits), integer).ptr - digits) }; break;
+            case Kind::TEXT: mine = text(); break;
+            default: return false;
+        }
+        return trimmed(mine) == trimmed(expected);
+    }
+
+private:
+    Kind kind_ = Kind::NONE;
+    int64_t integer = 0;
+    size_t length = 0;
+    char buffer[inlineCapacity] {};
+    std::string spilled;
+
+    [[nodiscard]] std::string_view text() const {
+        return length <= inlineCapacity ? std::string_view(buffer, length) : std::string_view(spilled);
+    }
+
+    static std::string_view trimmed(std::string_view s) {
+        while (! s.empty() && (s.back() == '\n' || s.back() == ' ' || s.back() == '\r' || s.back() == '\t')) s.remove_suffix(1);
+        return s;
+    }
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+/**
+ * Answers on disk, addressed by what determines them: the day, the part, the input bytes, and the exact build of the solvers.
+ * An unchanged input solved by an unchanged binary is then a file read, however slow the solver is.
+ *
+ * The build is identified by a hash of the executable itself, so any rebuild that changes code starts from an empty cache.
+ * Layout: <dir>/<build hash>/<day>-<part>-<input hash>, holding the answer text. Entries are written to a temporary file and
+ * renamed into place, so concurrent runs never see half an answer. Stale builds are not cleaned up; delete the directory at will.
+ */
+class ResultCache {
+public:
+    explicit ResultCache(std::filesystem::path dir) : dir(std::move(dir) / hex(buildId())) {}
+
+    [[nodiscard]] std::optional<std::string> get(int day, int part, std::string_view input) const {
+        std::ifstream f(path(day, part, input), std::ios::binary);
+        if (! f) return std::nullopt;
+        std::ostringstream s;
+        s << f.rdbuf();
+        return std::move(s).str();
+    }
+
+    // best effort: a cache that cannot be written to is only a slower cache.
+    void put(int day, int part, std::string_view input, const std::string& answer) const {
+        std::error_code ignored;
+        std::filesystem::create_directories(dir, ignored);
+
+        auto target = path(day, part, input);
+        auto temporary = target;
+        temporary += ".tmp" + std::to_string(getpid());
+        {
+            std::ofstream f(temporary, std::ios::binary);
+            if (! (f << answer)) {
+                f.close();
+                std::filesystem::remove(temporary, ignored);
+                return;
+            }
+        }
+        std::filesystem::rename(temporary, target, ignored);
+    }
+
+    // FNV-1a. Not cryptographic, but stable across builds and platforms, unlike std::hash.
+    static uint64_t hash(std::string_view bytes) {
+        uint64_t h = 0xcbf29ce484222325;
+        for (unsigned char c : bytes) {
+            h ^= c;
+            h *= 0x100000001b3;
+        }
+        return h;
+    }
+
+    // hash of this program's own executable, read once.
+    static uint64_t buildId() {
+        static const uint64_t id = [] {
+            std::ifstream f("/proc/self/exe", std::ios::binary);
+            std::ostringstream s;
+            s << f.rdbuf();
+            return hash(s.str());
+        }();
+        return id;
+    }
+
+private:
+    std::filesystem::path dir;
+
+    static std::string hex(uint64_t v) {
+        std::ostringstream s;
+        s << std::hex << v;
+        return s.str();
+    }
+
+    [[nodiscard]] std::filesystem::path path(int day, int part, std::string_view input) const {
+        return dir / (std::to_string(day) + "-" + std::to_string(part) + "-" + hex(hash(input)));
+    }
+};
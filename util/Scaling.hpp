@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Json.hpp"
+#include "Report.hpp"
+
+/**
+ * Empirical complexity: how a phase's time (or memory) grows with the size of its input.
+ *
+ * A power law y = c * n^k is a straight line in log-log space, so k is the slope of a least squares fit of log y against log n.
+ * Its error bar is the 95% confidence interval of that slope (Student's t on n - 2 degrees of freedom), which mostly says how
+ * straight the line is: constant overheads at small n or a change of regime (a cache level, n log n) bend it and widen the interval.
+ * The slope between the two largest sizes alone is the better guess for where the curve is heading.
+ */
+namespace Scaling {
+
+    struct Fit {
+        double exponent = 0;
+        double ci95 = 0; // half width.
+        double constant = 0; // c, in the unit of y.
+        double r2 = 0;
+        size_t points = 0; // used in the fit, y <= 0 cannot be on a log scale and is left out.
+
+        [[nodiscard]] bool valid() const { return points >= 2; }
+    };
+
+    // two-sided 95% quantile of Student's t.
+    inline double t975(size_t degreesOfFreedom) {
+        static constexpr double table[] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
+            2.120, 2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+        };
+        if (degreesOfFreedom == 0) return INFINITY;
+        return degreesOfFreedom <= std::size(table) ? table[degreesOfFreedom - 1] : 1.96;
+    }
+
+    inline Fit powerLaw(const std::vector<double>& n, const std::vector<double>& y) {
+        std::vector<double> lx, ly;
+        for (size_t i = 0; i < n.size() && i < y.size(); ++i) {
+            if (n[i] > 0 && y[i] > 0) {
+                lx.push_back(std::log(n[i]));
+                ly.push_back(std::log(y[i]));
+            }
+        }
+
+        Fit f;
+        f.points = lx.size();
+        if (! f.valid()) return f;
+
+        const auto k = static_cast<double>(f.points);
+        double mx = 0, my = 0;
+        for (size_t i = 0; i < f.points; ++i) {
+            mx += lx[i] / k;
+            my += ly[i] / k;
+        }
+        double sxx = 0, sxy = 0, syy = 0;
+        for (size_t i = 0; i < f.points; ++i) {
+            sxx += (lx[i] - mx) * (lx[i] - mx);
+            sxy += (lx[i] - mx) * (ly[i] - my);
+            syy += (ly[i] - my) * (ly[i] - my);
+        }
+        if (sxx == 0) {
+            f.points = 0; // every point at the same n.
+            return f;
+        }
+
+        f.exponent = sxy / sxx;
+        f.constant = std::exp(my - f.exponent * mx);
+        const double residual = std::max(0.0, syy - f.exponent * sxy);
+        f.r2 = syy > 0 ? 1 - residual / syy : 1;
+        f.ci95 = f.points > 2 ? t975(f.points - 2) * std::sqrt(residual / (k - 2) / sxx) : INFINITY;
+        return f;
+    }
+
+    // the slope between two points in log-log space.
+    inline double localExponent(double n1, double y1, double n2, double y2) {
+        if (n1 <= 0 || n2 <= 0 || y1 <= 0 || y2 <= 0 || n1 == n2) return NAN;
+        return std::log(y2 / y1) / std::log(n2 / n1);
+    }
+
+    // from, from * factor, ... up to and including 'to'. Rounded to whole sizes, without repeats.
+    inline std::vector<size_t> geometric(size_t from, size_t to, double factor) {
+        if (from == 0 || to < from || factor <= 1) throw std::invalid_argument("need 0 < from <= to and a factor above 1");
+        std::vector<size_t> sizes;
+        for (double n = static_cast<double>(from); n <= static_cast<double>(to) * (1 + 1e-9); n *= factor) {
+            auto rounded = static_cast<size_t>(std::llround(n));
+            if (sizes.empty() || rounded != sizes.back()) sizes.push_back(rounded);
+        }
+        return sizes;
+    }
+
+    // one phase at one size.
+    struct Point {
+        std::string phase;
+        size_t n;
+        size_t bytes; // of the generated input.
+        int samples;
+        double median; // ns
+        double p5;
+        double p95;
+        int64_t peakBytes; // -1 if not measured.
+        std::string peakOf; // "heap": peak live operator new bytes, when counted (AOC_TRACK_ALLOCATIONS). Otherwise "rss": the phase's peak RSS.
+    };
+
+    struct Curve {
+        std::string phase;
+        std::string of; // "time", or the memory measure of its points: "heap" or "rss".
+        Fit fit;
+        double tail; // local exponent between the two largest sizes.
+    };
+
+    inline void writeJson(std::ostream& o, int day, const std::string& unit, uint64_t seed, const std::vector<Point>& points, const std::vector<Curve>& curves) {
+        auto number = [](double d) { return std::isfinite(d) ? std::to_string(d) : std::string("null"); };
+        auto m = Report::metadata();
+        o << "{\n";
+        o << "  \"meta\": { \"host\": " << Json::quote(m.host) << ", \"compiler\": " << Json::quote(m.compiler)
+          << ", \"revision\": " << Json::quote(m.revision) << ", \"timestamp\": " << Json::quote(m.timestamp) << " },\n";
+        o << "  \"day\": " << day << ", \"unit\": " << Json::quote(unit) << ", \"seed\": " << seed << ",\n";
+        o << "  \"points\": [";
+        for (size_t i = 0; i < points.size(); ++i) {
+            auto& p = points[i];
+            o << (i ? ",\n" : "\n") << "    { \"phase\": " << Json::quote(p.phase) << ", \"n\": " << p.n << ", \"bytes\": " << p.bytes
+              << ", \"samples\": " << p.samples << ", \"median\": " << number(p.median) << ", \"p5\": " << number(p.p5) << ", \"p95\": " << number(p.p95);
+            if (p.peakBytes >= 0) o << ", \"peak_" << p.peakOf << "_bytes\": " << p.peakBytes;
+            o << " }";
+        }
+        o << "\n  ],\n  \"fits\": [";
+        for (size_t i = 0; i < curves.size(); ++i) {
+            auto& c = curves[i];
+            o << (i ? ",\n" : "\n") << "    { \"phase\": " << Json::quote(c.phase) << ", \"of\": " << Json::quote(c.of)
+              << ", \"exponent\": " << number(c.fit.exponent) << ", \"ci95\": " << number(c.fit.ci95) << ", \"constant\": " << number(c.fit.constant)
+              << ", \"r2\": " << number(c.fit.r2) << ", \"points\": " << c.fit.points << ", \"tail_exponent\": " << number(c.tail) << " }";
+        }
+        o << "\n  ]\n}\n";
+    }
+
+    // the points only, one row per phase and size, for plotting.
+    inline void writeCsv(std::ostream& o, int day, const std::vector<Point>& points) {
+        o << "day,phase,n,bytes,samples,median,p5,p95,peak_bytes,peak_of\n";
+        for (auto& p : points) {
+            o << day << "," << p.phase << "," << p.n << "," << p.bytes << "," << p.samples << "," << p.median << "," << p.p5 << "," << p.p95 << ",";
+            if (p.peakBytes >= 0) o << p.peakBytes << "," << p.peakOf;
+            else o << ",";
+            o << "\n";
+        }
+    }
+
+} // namespace Scaling
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Forward-only scanner over a byte buffer, for parsing puzzle input without streams.
+ *
+ * Nothing is copied: tokens come back as std::string_view into the scanned buffer.
+ * Integers are read 8 digits at a time with SWAR (SIMD within a register) when 8 bytes are left to read, and a digit at a time otherwise.
+ * Mismatches on expect() and missing digits on integer() throw std::invalid_argument, with the offending offset.
+ */
+class Scanner {
+public:
+    explicit Scanner(std::string_view data) : data(data) {}
+
+    [[nodiscard]] bool done() const { return pos >= data.size(); }
+    [[nodiscard]] size_t position() const { return pos; }
+    [[nodiscard]] std::string_view rest() const { return done() ? std::string_view{} : data.substr(pos); }
+
+    // '\0' when done, so a peek can be compared without checking done() first.
+    [[nodiscard]] char peek() const { return done() ? '\0' : data[pos]; }
+
+    char get() { return done() ? '\0' : data[pos++]; }
+
+    void skip(size_t n) { pos = std::min(data.size(), pos + n); }
+
+    // skips 'literal' if the input continues with it, and says whether it did.
+    bool skip(std::string_view literal) {
+        if (data.substr(pos).starts_with(literal)) {
+            pos += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    void expect(std::string_view literal) {
+        if (! skip(literal)) fail("expected '" + std::string(literal) + "'");
+    }
+
+    void skip_spaces() {
+        while (! done() && (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\r' || data[pos] == '\n')) ++pos;
+    }
+
+    // spaces and commas, the separators of every list in the puzzles.
+    void skip_separators() {
+        while (! done() && (data[pos] == ' ' || data[pos] == ',' || data[pos] == '\t' || data[pos] == '\r' || data[pos] == '\n')) ++pos;
+    }
+
+    // up to (not including) the next space, or the end.
+    std::string_view word() {
+        skip_spaces();
+        return until_any(" \t\r\n");
+    }
+
+    // up to (not including) the next 'c', or the end. The 'c' is consumed.
+    std::string_view until(char c) {
+        auto end = data.find(c, pos);
+        if (end == std::string_view::npos) end = data.size();
+        auto result = data.substr(pos, end - pos);
+        pos = std::min(data.size(), end + 1);
+        return result;
+    }
+
+    // up to (not including) the first of 'stops', or the end. The stop is not consumed.
+    std::string_view until_any(std::string_view stops) {
+        auto end = data.find_first_of(stops, pos);
+        if (end == std::string_view::npos) end = data.size();
+        auto result = data.substr(pos, end - pos);
+        pos = end;
+        return result;
+    }
+
+    // optionally signed decimal integer. Leading separators (spaces, commas) are skipped. One that does not fit in T fails.
+    template<std::integral T = int>
+    T integer() {
+        skip_separators();
+        bool negative = false;
+        if constexpr (std::is_signed_v<T>) {
+            if (peek() == '-') { negative = true; ++pos; }
+            else if (peek() == '+') { ++pos; }
+        }
+
+        uint64_t value = 0;
+        size_t start = pos;
+        while (true) {
+            int n = digits_ahead();
+            if (n == 0) break;
+            const uint64_t chunk = pos + 8 <= data.size() ? leading_digits(pos, n) : digit_run(pos, n);
+            if (__builtin_mul_overflow(value, pow10(n), &value) || __builtin_add_overflow(value, chunk, &value)) {
+                fail("number does not fit in 64 bits");
+            }
+            pos += n;
+            if (n < 8) break;
+        }
+        if (pos == start) fail("expected a number");
+
+        // the most negative value has one more than the most positive.
+        const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+        if (value > limit) fail("number out of range");
+        if (negative) return static_cast<T>(0 - value);
+        return static_cast<T>(value);
+    }
+
+    // every integer until the end, however they are separated.
+    template<std::integral T = int>
+    std::vector<T> integers() {
+        std::vector<T> result;
+        skip_separators();
+        while (! done()) {
+            result.push_back(integer<T>());
+            skip_separators();
+        }
+        return result;
+    }
+
+private:
+    std::string_view data;
+    size_t pos = 0;
+
+    [[noreturn]] void fail(const std::string& why) const {
+        throw std::invalid_argument("scan: " + why + " at offset " + std::to_string(pos) + " of '" + std::string(data.substr(0, 80)) + "'");
+    }
+
+    static constexpr uint64_t pow10(int n) {
+        uint64_t r = 1;
+        while (n-- > 0) r *= 10;
+        return r;
+    }
+
+    static constexpr uint64_t ones = 0x0101010101010101;
+
+    // the buffer, 8 bytes from 'at', as one little-endian word. Assumes at + 8 <= size.
+    [[nodiscard]] uint64_t load8(size_t at) const {
+        uint64_t chunk;
+        std::memcpy(&chunk, data.data() + at, 8);
+        if constexpr (std::endian::native == std::endian::big) chunk = __builtin_bswap64(chunk);
+        return chunk;
+    }
+
+    // how many digits follow, at most 8.
+    [[nodiscard]] int digits_ahead() const {
+        if (pos + 8 <= data.size()) {
+            uint64_t chunk = load8(pos);
+            // a byte is a digit iff its high nibble is 3 and adding 6 does not carry out of the low nibble (0x30..0x39).
+            // A carry out of a non-digit byte can corrupt the test of the byte after it, but only bytes before the first non-digit count.
+            uint64_t not_digit = ((chunk & (0xF0 * ones)) ^ (0x30 * ones)) | (((chunk + 0x06 * ones) & (0xF0 * ones)) ^ (0x30 * ones));
+            // sets the high bit of every byte of 'not_digit' that is not zero.
+            uint64_t nonzero = (((not_digit & (0x7F * ones)) + (0x7F * ones)) | not_digit) & (0x80 * ones);
+            return nonzero ? std::countr_zero(nonzero) / 8 : 8;
+        }
+
+        int n = 0;
+        while (n < 8 && pos + n < data.size() && data[pos + n] >= '0' && data[pos + n] <= '9') ++n;
+        return n;
+    }
+
+    // value of the 'n' (1 to 8) digits at 'at', by pairwise combining bytes: 8 -> 4 -> 2 -> 1 lanes, 3 multiplies instead of n.
+    // Shifting the digits to the top of the word drops whatever follows them, and fills in leading zeroes. Assumes at + 8 <= size.
+    [[nodiscard]] uint64_t leading_digits(size_t at, int n) const {
+        uint64_t v = (load8(at) & (0x0F * ones)) << (8 * (8 - n));
+        v = (v * (1 + (10 << 8))) >> 8;
+        v = ((v & 0x00FF00FF00FF00FF) * (1 + (100ull << 16))) >> 16;
+        return ((v & 0x0000FFFF0000FFFF) * (1 + (10000ull << 32))) >> 32;
+    }
+
+    [[nodiscard]] uint64_t digit_run(size_t at, int n) const {
+        uint64_t v = 0;
+        for (int i = 0; i < n; ++i) v = v * 10 + static_cast<uint64_t>(data[at + i] - '0');
+        return v;
+    }
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cerrno>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Json.hpp"
+#include "Scan.hpp"
+#include "SolverCache.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * The request loop of 'main [root] serve', over stdin/stdout or a Unix domain socket.
+ *
+ * A request is a header line "<id> <day> <part> <length>", then exactly <length> bytes of puzzle input.
+ * The reply is one JSON line: {"id", "answer", "cached", "us"}, or {"id", "error"}. Requests are solved on a thread pool,
+ * so replies come in the order they finish, not the order they were asked: match them up by id.
+ */
+namespace Serve {
+
+    // buffered reads from a file descriptor, for a header line or an exact number of bytes.
+    class Reader {
+    public:
+        explicit Reader(int fd) : fd(fd) {}
+
+        // false at end of input.
+        bool line(std::string& out) {
+            size_t end;
+            while ((end = buffer.find('\n')) == std::string::npos) {
+                if (! fill()) return false;
+            }
+            out = buffer.substr(0, end);
+            buffer.erase(0, end + 1);
+            return true;
+        }
+
+        // false if the input ends before 'n' bytes.
+        bool exactly(size_t n, std::string& out) {
+            while (buffer.size() < n) {
+                if (! fill()) return false;
+            }
+            out = buffer.substr(0, n);
+            buffer.erase(0, n);
+            return true;
+        }
+
+    private:
+        int fd;
+        std::string buffer;
+
+        bool fill() {
+            char chunk[1 << 16];
+            while (true) {
+                ssize_t n = read(fd, chunk, sizeof(chunk));
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return false;
+                buffer.append(chunk, n);
+                return true;
+            }
+        }
+    };
+
+    // one client. Closes its descriptors (unless they are stdin and stdout) once the last reply has been sent.
+    class Connection {
+    public:
+        Connection(int in, int out, bool owned) : in(in), out(out), owned(owned) {}
+        ~Connection() {
+            if (! owned) return;
+            close(in);
+            if (out != in) close(out);
+        }
+
+        Connection(const Connection&) = delete;
+        Connection& operator=(const Connection&) = delete;
+
+        void reply(const std::string& line) {
+            std::lock_guard lock(write_mutex);
+            std::string text = line + "\n";
+            for (size_t written = 0; written < text.size();) {
+                ssize_t n = write(out, text.data() + written, text.size() - written);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return; // the client is gone, nobody to tell.
+                written += n;
+            }
+        }
+
+        const int in;
+
+    private:
+        const int out;
+        const bool owned;
+        std::mutex write_mutex;
+    };
+
+    // reads requests from 'connection' until it closes, and hands each to 'pool'. Returns without waiting for the replies.
+    inline void handle(const std::shared_ptr<Connection>& connection, SolverCache& cache, ThreadPool& pool) {
+        Reader reader(connection->in);
+        std::string header;
+        while (reader.line(header)) {
+            if (header.empty()) continue;
+
+            std::string id;
+            int day, part;
+            size_t length;
+            try {
+                Scanner scan(header);
+                id = scan.word();
+                day = scan.integer();
+                part = scan.integer();
+                length = scan.integer<size_t>();
+            } catch (const std::exception& e) {
+                // without a length, there is no telling where the next request starts. Give up on this client.
+                connection->reply("{\"id\": " + Json::quote(id) + ", \"error\": " + Json::quote(e.what()) + "}");
+                return;
+            }
+
+            std::string input;
+            if (! reader.exactly(length, input)) {
+                connection->reply("{\"id\": " + Json::quote(id) + ", \"error\": \"input ended early\"}");
+                return;
+            }
+
+            pool.submit([connection, &cache, id, day, part, input = std::move(input)]() {
+                const auto start = std::chrono::steady_clock::now();
+                try {
+                    bool cached = false;
+                    auto answer = cache.solve(day, input, part, cached);
+                    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+                    connection->reply("{\"id\": " + Json::quote(id) + ", \"answer\": " + Json::quote(answer)
+                                      + ", \"cached\": " + (cached ? "true" : "false") + ", \"us\": " + std::to_string(us) + "}");
+                } catch (const std::exception& e) {
+                    connection->reply("{\"id\": " + Json::quote(id) + ", \"error\": " + Json::quote(e.what()) + "}");
+                }
+            });
+        }
+    }
+
+    // a listening Unix domain socket at 'path', replacing whatever was there. Throws std::runtime_error if it cannot be made.
+    inline int listenOn(const std::string& path) {
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) throw std::invalid_argument("socket path too long: " + path);
+        path.copy(address.sun_path, path.size());
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) throw std::runtime_error("serve: socket() failed");
+        unlink(path.c_str());
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, 64) != 0) {
+            close(fd);
+            throw std::runtime_error("serve: cannot listen on " + path);
+        }
+        return fd;
+    }
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <unistd.h>
+
+#include "Input.hpp"
+#include "ResultCache.hpp"
+
+/**
+ * A day's parsed state in binary, so a later run on the same input can map it in instead of parsing the text again.
+ *
+ * A snapshot sits next to its input, as <input>.snap. Its header names the solver that wrote it, the input bytes (hash) and the
+ * exact build (ResultCache::buildId), since the layout is whatever that build's save() wrote. A snapshot that does not match all
+ * three, or whose payload does not match its checksum, is ignored and overwritten. The payload is written by Writer and read back by Reader: trivially copyable values and
+ * arrays of them, each aligned, so an array can be used in place in the mapping without copying.
+ */
+namespace Snapshot {
+
+    struct Header {
+        char magic[8];
+        uint64_t solver; // hash of the solver's type name.
+        uint64_t input;
+        uint64_t build;
+        uint64_t size; // of the payload that follows.
+        uint64_t checksum; // of the payload, so a damaged one is parsed over rather than loaded.
+    };
+    static_assert(sizeof(Header) % 8 == 0, "the payload has to start 8-aligned, for Reader::array()");
+
+    constexpr char magic[8] = { 'A', 'O', 'C', 'S', 'N', 'A', 'P', '1' };
+
+    // FNV-1a over 8 bytes at a time, about eight times faster than ResultCache::hash. Only has to be stable within one build.
+    inline uint64_t checksum(std::string_view bytes) {
+        uint64_t h = 0xcbf29ce484222325;
+        size_t i = 0;
+        for (; i + 8 <= bytes.size(); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes.data() + i, 8);
+            h = (h ^ word) * 0x100000001b3;
+        }
+        for (; i < bytes.size(); ++i) h = (h ^ static_cast<unsigned char>(bytes[i])) * 0x100000001b3;
+        return h ^ bytes.size();
+    }
+
+    class Writer {
+    public:
+        template<typename T>
+        void put(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= 8);
+            align(alignof(T));
+            data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        // the count, then the values.
+        template<typename T>
+        void put(std::span<const T> values) {
+            static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= 8);
+            put<uint64_t>(values.size());
+            align(alignof(T));
+            data.append(reinterpret_cast<const char*>(values.data()), values.size_bytes());
+        }
+
+        [[nodiscard]] std::string_view bytes() const { return data; }
+
+    private:
+        std::string data;
+
+        void align(size_t alignment) { data.resize((data.size() + alignment - 1) / alignment * alignment, '\0'); }
+    };
+
+    // reads back what a Writer wrote, in the same order. Throws std::invalid_argument if the payload runs out.
+    class Reader {
+    public:
+        explicit Reader(std::string_view payload) : data(payload) {}
+
+        template<typename T>
+        T get() {
+            static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= 8);
+            align(alignof(T));
+            need(sizeof(T));
+            T value;
+            std::memcpy(&value, data.data() + pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+
+        // points into the snapshot, valid while it is mapped.
+        template<typename T>
+        std::span<const T> array() {
+            static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= 8);
+            const auto count = get<uint64_t>();
+            align(alignof(T));
+            need(0);
+            if (count > (data.size() - pos) / sizeof(T)) throw std::invalid_argument("snapshot: truncated");
+            std::span<const T> values(reinterpret_cast<const T*>(data.data() + pos), count);
+            pos += values.size_bytes();
+            return values;
+        }
+
+        [[nodiscard]] bool done() const { return pos >= data.size(); }
+
+    private:
+        std::string_view data;
+        size_t pos = 0;
+
+        void align(size_t alignment) { pos = (pos + alignment - 1) / alignment * alignment; }
+
+        void need(size_t bytes) const {
+            if (pos > data.size() || data.size() - pos < bytes) throw std::invalid_argument("snapshot: truncated");
+        }
+    };
+
+    inline std::filesystem::path pathFor(const std::filesystem::path& input) {
+        auto p = input;
+        p += ".snap";
+        return p;
+    }
+
+    // a snapshot, or one still being written, rather than an input. For listing a directory of inputs.
+    inline bool isSnapshot(const std::filesystem::path& path) {
+        const auto name = path.filename().string();
+        return name.ends_with(".snap") || name.find(".snap.tmp") != std::string::npos;
+    }
+
+    inline uint64_t solverId(std::string_view typeName) { return ResultCache::hash(typeName); }
+
+    // the snapshot at 'path', mapped, if it was written by 'solver' for exactly 'input' and by this build.
+    inline std::optional<MappedFile> open(const std::filesystem::path& path, uint64_t solver, std::string_view input) {
+        std::error_code missing;
+        if (! std::filesystem::is_regular_file(path, missing)) return std::nullopt;
+
+        MappedFile file(path);
+        auto bytes = file.view();
+        if (bytes.size() < sizeof(Header)) return std::nullopt;
+        Header h {};
+        std::memcpy(&h, bytes.data(), sizeof(Header));
+        if (std::memcmp(h.magic, magic, sizeof(magic)) != 0 || h.solver != solver || h.build != ResultCache::buildId()
+            || h.size != bytes.size() - sizeof(Header) || h.input != checksum(input) || h.checksum != checksum(bytes.substr(sizeof(Header)))) {
+            return std::nullopt;
+        }
+        return file;
+    }
+
+    inline Reader reader(const MappedFile& snapshot) { return Reader(snapshot.view().substr(sizeof(Header))); }
+
+    // best effort, like ResultCache::put: an input directory that cannot be written to only means parsing next time too.
+    inline void write(const std::filesystem::path& path, uint64_t solver, std::string_view input, const Writer& payload) {
+        Header h {};
+        std::memcpy(h.magic, magic, sizeof(magic));
+        h.solver = solver;
+        h.input = checksum(input);
+        h.build = ResultCache::buildId();
+        h.size = payload.bytes().size();
+        h.checksum = checksum(payload.bytes());
+
+        std::error_code ignored;
+        auto temporary = path;
+        temporary += ".tmp" + std::to_string(getpid());
+        {
+            std::ofstream f(temporary, std::ios::binary);
+            f.write(reinterpret_cast<const char*>(&h), sizeof(Header));
+            f.write(payload.bytes().data(), static_cast<std::streamsize>(payload.bytes().size()));
+            if (! f) {
+                f.close();
+                std::filesystem::remove(temporary, ignored);
+                return;
+            }
+        }
+        std::filesystem::rename(temporary, path, ignored);
+    }
+
+} // namespace Snapshot
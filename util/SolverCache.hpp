@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Day.hpp"
+
+/**
+ * Parsed solvers, keyed by day and a hash of the input bytes, so asking about the same input again skips parse() entirely.
+ *
+ * Any number of threads may solve() at once. Each entry is parsed exactly once (the first thread to need it parses, others wait),
+ * and after that v1() and v2() run on it concurrently: they are const, and Day::answer keeps their results apart.
+ * Holds at most 'capacity' solvers, dropping the least recently used. A dropped solver stays alive until its last caller is done.
+ */
+class SolverCache {
+public:
+    using Factory = std::function<std::unique_ptr<Day>(int day, MappedFile input)>;
+
+    SolverCache(Factory make, size_t capacity) : make(std::move(make)), capacity(std::max<size_t>(1, capacity)) {}
+
+    // the answer to 'part' of 'day' for 'input'. 'cached' says whether the input was already parsed.
+    std::string solve(int day, std::string_view input, int part, bool& cached) {
+        auto entry = lookup(day, input, cached);
+        std::call_once(entry->parsed, [&]() { entry->solver->prepare(); });
+        return entry->solver->answer(part);
+    }
+
+    [[nodiscard]] size_t size() {
+        std::lock_guard lock(mutex);
+        return entries.size();
+    }
+
+private:
+    struct Entry {
+        std::unique_ptr<Day> solver;
+        std::once_flag parsed; // not set if parse() threw, so the next caller tries again.
+    };
+
+    using Key = std::pair<int, size_t>; // day, hash of the input.
+    using Recency = std::list<Key>; // most recently used first.
+
+    Factory make;
+    size_t capacity;
+    std::mutex mutex; // over everything below. Not held while parsing or solving.
+    std::map<Key, std::pair<std::shared_ptr<Entry>, Recency::iterator>> entries;
+    Recency recency;
+
+    std::shared_ptr<Entry> lookup(int day, std::string_view input, bool& cached) {
+        const Key key { day, std::hash<std::string_view>{}(input) };
+
+        std::lock_guard lock(mutex);
+        auto iter = entries.find(key);
+        // comparing the bytes too, to tell inputs apart that happen to share a hash.
+        if (iter != entries.end() && iter->second.first->solver->inputText() == input) {
+            recency.splice(recency.begin(), recency, iter->second.second);
+            cached = true;
+            return iter->second.first;
+        }
+
+        if (iter != entries.end()) { // a collision: the newer input takes the slot.
+            recency.erase(iter->second.second);
+            entries.erase(iter);
+        }
+        while (entries.size() >= capacity) {
+            entries.erase(recency.back());
+            recency.pop_back();
+        }
+
+        auto entry = std::make_shared<Entry>();
+        entry->solver = make(day, MappedFile::fromBytes(std::string(input)));
+        recency.push_front(key);
+        entries.emplace(key, std::make_pair(entry, recency.begin()));
+        cached = false;
+        return entry;
+    }
+};
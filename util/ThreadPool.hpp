@@ -0,0 +1,103 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <exception>
+
+#include "Affinity.hpp"
+
+/**
+ * Fixed-size pool of worker threads, each optionally pinned to its own CPU.
+ *
+ * Tasks are handed out first-in first-out, so whoever submits decides the scheduling order
+ * (e.g. longest-expected-first). wait() blocks until every submitted task has finished,
+ * and rethrows the first exception a task threw, if any.
+ */
+class ThreadPool {
+public:
+    // cpus: one entry per worker, the CPU it gets pinned to. Empty means 'n_workers' unpinned workers.
+    explicit ThreadPool(int n_workers, const std::vector<int>& cpus = {}) {
+        for (int i = 0; i < n_workers; ++i) {
+            int cpu = cpus.empty() ? -1 : cpus.at(i % cpus.size());
+            workers.emplace_back([this, cpu]() {
+                if (cpu >= 0) Affinity::pinCurrentThread(cpu);
+                work();
+            });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        has_work.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard lock(mutex);
+            tasks.emplace_back(std::move(task));
+            ++unfinished;
+        }
+        has_work.notify_one();
+    }
+
+    void wait() {
+        std::unique_lock lock(mutex);
+        all_done.wait(lock, [this]() { return unfinished == 0; });
+
+        if (first_error) {
+            auto e = first_error;
+            first_error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    [[nodiscard]] size_t size() const { return workers.size(); }
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable has_work;
+    std::condition_variable all_done;
+    size_t unfinished = 0;
+    bool stopping = false;
+    std::exception_ptr first_error;
+
+    void work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex);
+                has_work.wait(lock, [this]() { return stopping || ! tasks.empty(); });
+                if (tasks.empty()) return; // stopping, and nothing left to do.
+
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard lock(mutex);
+                if (! first_error) first_error = std::current_exception();
+            }
+
+            {
+                std::lock_guard lock(mutex);
+                --unfinished;
+            }
+            all_done.notify_all();
+        }
+    }
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "Json.hpp"
+
+/**
+ * Scoped timing zones inside a phase, for seeing where a solver spends its time in a trace viewer (chrome://tracing, Perfetto).
+ *
+ * TRACE_ZONE("name") times the rest of its scope. Zones nest, and every thread records into a ring buffer of its own, so there is
+ * no locking on the hot path, and a long run keeps its most recent events rather than running out of memory.
+ * Like Log, it is gated twice: compiled out entirely unless CMake's AOC_TRACING is on, and even then recording only happens
+ * after Trace::setEnabled(true), which the 'trace' run mode does. 'name' must be a string literal, or at least outlive the export.
+ */
+namespace Trace {
+
+    struct Event {
+        const char* name;
+        int64_t start; // ns since the process epoch.
+        int64_t duration; // ns.
+    };
+
+    class Buffer {
+    public:
+        static constexpr size_t CAPACITY = 1 << 16;
+
+        explicit Buffer(int thread) : thread(thread) { events.reserve(CAPACITY); }
+
+        void record(const Event& e) {
+            if (events.size() < CAPACITY) events.push_back(e);
+            else events[recorded % CAPACITY] = e;
+            ++recorded;
+        }
+
+        // oldest first.
+        template<typename F> void each(F&& f) const {
+            size_t first = recorded > CAPACITY ? recorded % CAPACITY : 0;
+            for (size_t i = 0; i < events.size(); ++i) f(events[(first + i) % events.size()]);
+        }
+
+        [[nodiscard]] size_t dropped() const { return recorded > CAPACITY ? recorded - CAPACITY : 0; }
+
+        const int thread; // small sequential id, in order of first use. Not the OS thread id.
+
+    private:
+        std::vector<Event> events;
+        size_t recorded = 0;
+    };
+
+    inline std::atomic<bool> on { false };
+    inline std::mutex registry_mutex;
+    inline std::vector<std::shared_ptr<Buffer>> registry; // outlives the threads, so their events can still be exported.
+
+    inline bool compiled() {
+#ifdef AOC_TRACE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    inline void setEnabled(bool enabled) { on.store(enabled, std::memory_order_relaxed); }
+    inline bool enabled() { return on.load(std::memory_order_relaxed); }
+
+    inline int64_t now() {
+        static const auto epoch = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    inline Buffer& local() {
+        thread_local std::shared_ptr<Buffer> buffer = [] {
+            std::lock_guard lock(registry_mutex);
+            auto b = std::make_shared<Buffer>(static_cast<int>(registry.size()));
+            registry.push_back(b);
+            return b;
+        }();
+        return *buffer;
+    }
+
+    class Zone {
+    public:
+        explicit Zone(const char* name) : name(name), start(enabled() ? now() : -1) {}
+        ~Zone() { if (start >= 0) local().record({ name, start, now() - start }); }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* name;
+        int64_t start; // -1 if tracing was off when the zone was entered.
+    };
+
+    // every recorded event, as Chrome trace_event JSON. Call once the traced work is done, the buffers are read without locking.
+    inline void writeChrome(std::ostream& o) {
+        std::lock_guard lock(registry_mutex);
+        o << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        auto separator = [&]() -> std::ostream& { o << (first ? "\n" : ",\n"); first = false; return o; };
+
+        for (auto& buffer : registry) {
+            separator() << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->thread
+                        << R"(,"args":{"name":"thread )" << buffer->thread << "\"}}";
+            // trace_event timestamps are in microseconds, fractions allowed.
+            buffer->each([&](const Event& e) {
+                separator() << R"({"name":)" << Json::quote(e.name) << R"(,"ph":"X","pid":1,"tid":)" << buffer->thread
+                            << R"(,"ts":)" << static_cast<double>(e.start) / 1000 << R"(,"dur":)" << static_cast<double>(e.duration) / 1000 << "}";
+            });
+        }
+        o << "\n]}\n";
+    }
+
+    // events lost to the ring buffers wrapping around, over all threads.
+    inline size_t dropped() {
+        std::lock_guard lock(registry_mutex);
+        size_t total = 0;
+        for (auto& buffer : registry) total += buffer->dropped();
+        return total;
+    }
+}
+
+#define AOC_TRACE_CONCAT_(a, b) a##b
+#define AOC_TRACE_CONCAT(a, b) AOC_TRACE_CONCAT_(a, b)
+
+#ifdef AOC_TRACE
+#define TRACE_ZONE(name) Trace::Zone AOC_TRACE_CONCAT(trace_zone_, __LINE__) { name }
+#else
+#define TRACE_ZONE(name) static_cast<void>(0)
+#endif
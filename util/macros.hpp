@@ -2,5 +2,5 @@
 
 #define CONCATENATE(x, y) x##y
 #define CLASS_DEF(D) class CONCATENATE(Day, D) : public Day
-#define DEFAULT_CTOR_DEF(D) CONCATENATE(Day, D) () : Day(D) {}
+#define DEFAULT_CTOR_DEF(D) CONCATENATE(Day, D) () : Day(D) {} explicit CONCATENATE(Day, D) (const std::string& inputFilePath) : Day(inputFilePath) {} explicit CONCATENATE(Day, D) (MappedFile input) : Day(std::move(input)) {}
 #define NAMESPACE_DEF(D) namespace CONCATENATE(Day, D)
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 #define PLACEHOLD(DAY) NAMESPACE_DEF(DAY) { CLASS_DEF(DAY) { \
 public: DEFAULT_CTOR_DEF(DAY)                       \
-    void parse(std::ifstream&) override {           \
+    void parse(Input&) override {           \
         throw std::runtime_error("Not Implemented");\
     }                                               \
     void parseBenchReset() override {               \